@@ -1,575 +1,7376 @@
-//=========================================================================
-// Description:
-//    This program allows the user to
-//    a) Generate a population file, including the birth & death years of each person.
-//        The range of each person's life span is trimmed to be between 1900 and 2000, inclusively.
-//    b) Process the file and report the year that the maximum number of people were alive.
-//       If the maximum occurs in multile years, all years will be reported.
-//
-// Usage: SGI_WhosAlive populationFile [sizeOfPopulationToGenerate]
-//    Where
-//       'populationFile'             is the file to read from or write to,
-//       'sizeOfPopulationToGenerate' is an integer specifying the number of records to generate for the file.
-//    If no population size is specified, simply read and process the populationFile.
-//=========================================================================
-
-
-#include <iostream>        // for cout
-#include <fstream>         // for ofstream,ifstream
-#include <sstream>         // for stringstream
-#include <time.h>          // for rand() seed
-#include <assert.h>        // for assert
-#include <vector>          // for vector
-#include <list>            // for list
-#include <memory>          // for weak_ptr
-#include <algorithm>       // for min/max
-using namespace std;
-
-// Range, in years, of the population
-#define RANGE_YEAR_END (2000)
-#define RANGE_YEAR_BEG (1900)
-
-// Semi-Realistic Life Span constants
-#define MAX_AGE (130)
-#define RANGE_YEAR_MIN   (RANGE_YEAR_BEG-MAX_AGE+1)
-#define RANGE_AGEAVG_END (90)      // Average person lives to somewhere in this range
-#define RANGE_AGEAVG_BEG (60)
-#define RANGE_AGEOUT_END (MAX_AGE) // Outliers live to somewhere in this range (overlaps Average range)
-#define RANGE_AGEOUT_BEG (40)
-#define RANGE_AGEMID_END (30)      // The invincible years (new drivers, drinking, ...) deaths happen somewhere in this range
-#define RANGE_AGEMID_BEG (16)
-#define RANGE_AGENEW_END (1)       // short-lived NewBorns live to somewhere in this range
-#define RANGE_AGENEW_BEG (0)
-#define RANGE_AGEBAD_END (RANGE_AGEOUT_END)    // BadLuck/Accidents can happen any time (overlaps all ranges)
-#define RANGE_AGEBAD_BEG (RANGE_AGENEW_BEG)
-
-//--------------------------------------------------------------------------
-// Name: struct _vitalStats()
-// Desc: container for personal info (name, years of birth & death)
-//--------------------------------------------------------------------------
-typedef struct _vitalStats
-{
-public:
-    _vitalStats(string first, string last, int yrBirth, int yrDeath)
-    {
-        _first   = first;
-        _last    = last;
-        _yrBirth = yrBirth;
-        _yrDeath = yrDeath;
-        if (yrBirth > yrDeath)
-            throw false;
-    }
-
-    // accessors
-    string &firstName() { return _first;   }
-    string &lastName()  { return _last;    }
-    int     birthYear() { return _yrBirth; }
-    int     deathYear() { return _yrDeath; }
-private:
-    string _first;   // first name
-    string _last;    // last  name
-    int    _yrBirth; // RANGE_YEAR_BEG 'trimmed' year of birth
-    int    _yrDeath; // RANGE_YEAR_END 'trimmed' year of death
-} vitalStats_t;
-
-//=========================================================================
-// Name:    class argsAndErrs
-// Desc:
-//          object for
-//          * accepting, sanity checking, and maintaining command line arguments
-//          * reporting errors
-//          * providing accessors to command line arguments and their derivatives
-//=========================================================================
-class argsAndErrs
-{
-public:
-    argsAndErrs() : _sizeOfPopulation(-1) {}
-public:
-    enum { eCmdLnArg_AppPath, eCmdLnArg_PopFile, eCmdLnArg_PopSize };
-    bool initWithArgs(int argc, const char * argv[], string &strErr);
-    void reportErr(string strErr="");
-    bool needData() { return (_sizeOfPopulation==-1) ? false : true; }
-    friend class populationInfo; // needs access to protected functions
-protected:
-    void         addCmdLnArgsToErr(stringstream &ss);
-    long long    populationSize() { return _sizeOfPopulation; }
-    const string populationFile() { return _filePopulation; }
-    
-private:
-    vector<string> _args;               // command line args
-    string         _filePopulation;     // CLA[1] - population file to use
-    long long      _sizeOfPopulation;   // CLA[2] - optional size of popuation -> generates file
-};
-typedef argsAndErrs argsAndErrs_t;
-
-//=========================================================================
-// Name:    class populationInfo
-// Desc:
-//          object for processing population-relevant command line arguments or commands.
-//          Includes:
-//          * generateVitalStats()    - generates a semi-realistice population data set
-//          * findMaxPopulationYear() - finds and outputs the year(s) that had the most people alive
-//=========================================================================
-class populationInfo
-{
-public:
-    populationInfo(weak_ptr<argsAndErrs_t>  wpFb) : _delim(';') { _wpFb = wpFb; }
-    void generateVitalStats();
-    void findMaxPopulationYear();
-private:
-    vector<string> deliminatedStringToTokens(const string &inpStr);
-private:
-    weak_ptr<argsAndErrs_t> _wpFb;      // hasa argsAndErrs_t
-    const char              _delim;     // intra-record delimiter used to generate and parse data set info.
-};
-
-//--------------------------------------------------------------------------
-// Name: initWithArgs()
-// Desc:
-//      * Accept input stings (putting them into m_args list)
-//      * population file
-//      * optional size of population (will generate a file)
-// Params:
-//       argc   - number of arguments
-//       argv   - array of argument strings
-//       strErr - if error, message to output
-// Returns:
-//      false if success; true if error
-//--------------------------------------------------------------------------
-bool argsAndErrs::initWithArgs(int argc, const char * argv[], string &strErr)
-{
-    // Accept input stings (putting them into m_args list)
-    for (int ix = eCmdLnArg_AppPath; ix < argc; ix++)
-    {
-        _args.push_back(argv[ix]);
-    }
-
-    bool fDoBreak = false;
-    do
-    {
-        for (int ixCmdLnArg = eCmdLnArg_PopFile; ixCmdLnArg < argc; ixCmdLnArg++)
-        {
-            switch (ixCmdLnArg)
-            {
-                case eCmdLnArg_PopFile:
-                    _filePopulation = argv[eCmdLnArg_PopFile];
-                    break;
-                case eCmdLnArg_PopSize:
-                    if (argc == eCmdLnArg_PopSize+1)
-                    {
-                        _sizeOfPopulation = 0;
-                        try
-                        {
-                            _sizeOfPopulation = stoll(argv[eCmdLnArg_PopSize]);
-                        }
-                        catch (...)
-                        {
-                            stringstream ss;
-                            ss <<  "    Problem with argment[" << ixCmdLnArg << "]." << endl;
-                            ss <<  "        '"<<argv[ixCmdLnArg]<<"'. Needs to be a valid integer, specifying the desired population size." << endl;
-                            addCmdLnArgsToErr(ss);
-                            strErr = ss.str();
-                            fDoBreak = true;
-                        }
-                    }
-                    break;
-                default:
-                    {
-                        stringstream ss;
-                        ss <<  "    Too many CmdLineArgs." << endl;
-                        addCmdLnArgsToErr(ss);
-                        strErr = ss.str();
-                        fDoBreak = true;
-                    }
-                    break;
-            }
-        }
-        if (fDoBreak)
-            break;
-        
-        if (_sizeOfPopulation == -1)
-        {
-            // ensure the file exists
-            ifstream file;
-            file.open (_filePopulation.c_str());
-            if (file.is_open())
-                file.close();
-            else if (argc > eCmdLnArg_PopFile)
-            {
-                stringstream ss;
-                ss <<  "    Problem with argment[" << eCmdLnArg_PopFile << "]." << endl;
-                ss <<  "        '"<<argv[eCmdLnArg_PopFile]<<"' does not exist." << endl;
-                addCmdLnArgsToErr(ss);
-                strErr = ss.str();
-                fDoBreak = true;
-            }
-            else
-            {
-                stringstream ss;
-                ss <<  "    This program requires at least 1 argment (name of population file)" << endl;
-                addCmdLnArgsToErr(ss);
-                strErr = ss.str();
-                fDoBreak = true;
-            }
-        }
-    } while (false);
-    
-    
-    return fDoBreak;
-} //initWithArgs()
-
-//--------------------------------------------------------------------------
-// Name: reportErr()
-// Desc:
-//      output out an error message to std out
-//      * Error Message (if any) is prefixed with an application usage message
-// Params:
-//       strErr - error message to output
-// Returns:
-//      void
-//--------------------------------------------------------------------------
-void argsAndErrs::reportErr(string strErr/*""*/)
-{
-    #define PATH_U_DELIM ('/')
-    #define PATH_W_DELIM ('\\')
-    #define PATH_C_DELIM (':')
-    
-    // trim application path
-    static char PATH_DELIMS[] = { PATH_U_DELIM, PATH_W_DELIM, PATH_C_DELIM };
-    string appName = _args.size() ? *_args.begin() : "<NoAppName>";
-    size_t posPathDelim = appName.find_last_of(PATH_DELIMS);
-    if(string::npos != posPathDelim)
-    {
-        appName = appName.substr(posPathDelim+1);
-    }
-    
-    cerr << endl;
-    cerr << "Description:" << endl;
-    cerr << "   This program allows the user to " << endl;
-    cerr << "   a) Generate a population file, including the birth & death years of each person." << endl;
-    cerr << "   b) Process the file and report the year that the maximum number of people were alive." << endl;
-    cerr << "      If the maximum occurs in multile years, all years will be reported." << endl;
-    cerr << endl;
-    cerr << "Usage: " << appName << " populationFile [sizeOfPopulationToGenerate]" << endl;
-    cerr << "   Where " << endl;
-    cerr << "      'populationFile'             is the file to read from or write to," << endl;
-    cerr << "      'sizeOfPopulationToGenerate' is an integer specifying the number of records to generate for the file." << endl;
-    cerr << "   If no population size is specified, this program will simply read and process the populationFile."  << endl;
-    cerr << endl;
-    if (strErr.length())
-    {
-        cerr << "Error: " << endl;
-        cerr << strErr;
-    }
-} // reportErr()
-
-
-//--------------------------------------------------------------------------
-// Name: addCmdLnArgsToErr()
-// Desc:
-//      add the (post application name) Command Line Args to the current stream
-// Params:
-//       ss - output string stream to append to
-// Returns:
-//      void
-//--------------------------------------------------------------------------
-void argsAndErrs::addCmdLnArgsToErr(stringstream &ss)
-{
-    size_t ix=eCmdLnArg_AppPath;
-    for (auto itCmdLnArg = _args.begin(); itCmdLnArg != _args.end(); ++itCmdLnArg)
-        ss <<  "        param[" << ix++ << "] = " << *itCmdLnArg << endl;
-} // addCmdLnArgsToErr()
-
-
-
-
-//--------------------------------------------------------------------------
-// Name: generateVitalStats()
-// Desc:
-//       Generate semi-realistic birth death years for people living in the desired time frame (RANGE_YEAR_BEG to RANGE_YEAR_END)
-//       NOTE: this will generate births before the RANGE_YEAR_BEG and deaths after RANGE_YEAR_END for semi-realistic life spans,
-//             then it will clip the ages to the desired time frame.
-//             This generates a relatively FLAT population curve of the range.
-//             Had we set RANGE_YEAR_MIN to RANGE_YEAR_BEG, we would get an upward ramping curve.
-//             Had we only only allowed people who died in the range to be counted, we could get a downward ramping curve.
-//             Had we only only allowed people who were born and died in the range to be counted, we could get a bell curve maximize around 1950.
-// Params:
-//       <none>
-// Returns:
-//      void
-//--------------------------------------------------------------------------
-void populationInfo::generateVitalStats()
-{
-    time_t secSinceEpoc; time(&secSinceEpoc);
-    srand(secSinceEpoc);
-    
-    vector<vitalStats_t> vPopulationStats;
-    
-    do
-    {
-        shared_ptr<argsAndErrs_t> pFB = _wpFb.lock();
-        if (pFB==nullptr || pFB.get()==nullptr)
-            break;
-        
-        long long populationSize = pFB->populationSize();
-        cout << "generating "<< populationSize << " records..." << endl;
-    
-        while (populationSize)
-        {
-            // Make some babies
-            int yrBirth  = (rand() % (RANGE_YEAR_END  - RANGE_YEAR_MIN))  + RANGE_YEAR_MIN;
-            
-            // For whom does the bell toll?
-            int inpBias  =  rand() % 100;
-            int yrAlive  = (inpBias > 60) ? (rand() % (RANGE_AGEAVG_END  - RANGE_AGEAVG_BEG))  + RANGE_AGEAVG_BEG
-                         : (inpBias > 30) ? (rand() % (RANGE_AGEOUT_END  - RANGE_AGEOUT_BEG))  + RANGE_AGEOUT_BEG
-                         : (inpBias > 20) ? (rand() % (RANGE_AGENEW_END  - RANGE_AGENEW_BEG))  + RANGE_AGENEW_BEG
-                         : (inpBias > 10) ? (rand() % (RANGE_AGEMID_END  - RANGE_AGEMID_BEG))  + RANGE_AGEMID_BEG
-                         :                  (rand() % (RANGE_AGEBAD_END  - RANGE_AGEBAD_BEG))  + RANGE_AGEBAD_BEG
-                         ;
-            int yrDeath = yrBirth + yrAlive;
-            
-            if (yrDeath > RANGE_YEAR_BEG)
-            {
-                // Could have used a name generation site like: http://listofrandomnames.com/, but since names are not relevant to the problem...
-                // Obfuscate/Redact 'real' names for privacy protection ;)
-                vPopulationStats.push_back(_vitalStats("<Name Redacted>", "<For Privacy>", max(RANGE_YEAR_BEG, yrBirth), min(RANGE_YEAR_END,yrDeath)));
-                populationSize--;
-            }
-        }
-
-        cout << "generated "<< vPopulationStats.size() << " records." << endl;
-        cout << "adding  "  << vPopulationStats.size() << " records to file '" << pFB->populationFile().c_str() << "'" << endl;
-        
-        ofstream outStream;
-        outStream.open(pFB->populationFile().c_str());
-        if (outStream.is_open())
-        {
-            for (auto person : vPopulationStats)
-            {
-                outStream << person.firstName() << _delim // eFileTokenFName
-                          << person.lastName()  << _delim // eFileTokenLName
-                          << person.birthYear() << _delim // eFileTokenBYear
-                          << person.deathYear() << endl;  // eFileTokenDYear
-            }
-            outStream.close();
-            cout << "added  "  << vPopulationStats.size() << " records to file '" << pFB->populationFile().c_str() << "'" << endl;
-        }
-        else
-        {
-            {
-                stringstream ss;
-                ss <<  "    Unable to open specified file,'" << pFB->populationFile().c_str() << "', for write." << endl;
-                pFB->addCmdLnArgsToErr(ss);
-                string strErr = ss.str();
-                pFB.get()->reportErr(strErr);
-            }
-        }
-    } while (false);
-}
-
-//--------------------------------------------------------------------------
-// Name: deliminatedStringToTokens()
-// Desc:
-//        returns a vector of substrings that were delimited by the specified token
-// Params:
-//       inpStr - a string, delimited by _delim (in generateVitalStats())
-// Returns:
-//      vector of substrings
-//--------------------------------------------------------------------------
-vector<string> populationInfo::deliminatedStringToTokens(const string &inpStr)
-{
-    vector<string> tokens;
-
-    do
-    {
-        auto itToken=inpStr.begin();
-        for (auto itInp=itToken; itInp!=inpStr.end(); ++itInp)
-        {
-            if (*itInp == _delim)
-            {
-                tokens.push_back(string(itToken,itInp));
-                itToken = itInp+1;
-            }
-        }
-        tokens.push_back(string(itToken,inpStr.end()));
-
-    } while (false);
-
-    return tokens;
-}
-
-//--------------------------------------------------------------------------
-// Name: findMaxPopulationYear()
-// Desc:
-//        Process the file and report the year that the maximum number of people were alive.
-//        If the maximum occurs in multile years, all years will be reported
-// Params:
-//       <none>
-// Returns:
-//      void
-//--------------------------------------------------------------------------
-void populationInfo::findMaxPopulationYear()
-{
-    vector<vitalStats_t> vPopulationStats;
-    
-    bool fDoBreak = false;
-    do
-    {
-        shared_ptr<argsAndErrs_t> pFB = _wpFb.lock();
-        if (pFB==nullptr || pFB.get()==nullptr)
-            break;
-        
-        vector<long long>airBreathers(RANGE_YEAR_END-RANGE_YEAR_BEG+1, 0);
-        list<long long> MaxYears;
-
-        long long maxAlive = 0;
-         cout << "reading records from file '" << pFB->populationFile().c_str() << "'" << endl;
-   
-        ifstream inpStream;
-        inpStream.open(pFB->populationFile().c_str());
-        if (inpStream.is_open())
-        {
-            string strDelimitedLine;
-            vector<vitalStats_t> vPopulationStats;
-            
-            long long ixRecord=0;
-            int yrBirth;
-            int yrDeath;
-            while (getline(inpStream, strDelimitedLine))
-            {
-                ixRecord++;
-                enum { eFileTokenFName, eFileTokenLName, eFileTokenBYear, eFileTokenDYear };
-                vector<string> tokens = deliminatedStringToTokens(strDelimitedLine);
-                
-                        try
-                        {
-                            yrBirth = stoi(tokens[eFileTokenBYear]);
-                            yrDeath = stoi(tokens[eFileTokenDYear]);
-                        }
-                        catch (...)
-                        {
-                            stringstream ss;
-                            ss <<  "    File corrupted at record " << ixRecord << "." << endl;
-                            ss <<  "    Expecting '"<<tokens[eFileTokenBYear]<<"' to be a valid integer" << endl;
-                            ss <<  "    Expecting '"<<tokens[eFileTokenDYear]<<"' to be a valid integer" << endl;
-                            pFB->addCmdLnArgsToErr(ss);
-                            string strErr = ss.str();
-                            pFB.get()->reportErr(strErr);
-                            fDoBreak = true;
-                            break;
-                        }
-                        // _vitalStats stats(tokens[eFileTokenFName],tokens[eFileTokenLName], yrBirth, yrDeath);
-
-                // Add this person's alive years to the population count for each year in range
-                int ixAlive  = yrBirth - RANGE_YEAR_BEG;
-                int lastYear = yrDeath - RANGE_YEAR_BEG;
-                for (; ixAlive <= lastYear; ixAlive++)
-                {
-                    long long cntAlive = ++airBreathers[ixAlive]; // this person is alive this year
-
-                    if (cntAlive > maxAlive)
-                    {
-                        // This year now has the largest population
-                        MaxYears.clear();
-                        MaxYears.push_back(ixAlive);
-                        maxAlive = cntAlive;
-                    }
-                    else if (cntAlive == maxAlive)
-                    {
-                        MaxYears.push_back(ixAlive);
-                    }
-                } // for each year that the person is alive
-
-
-// Simple graph to show population
-//printf("yrBirth:%d   yrDeath:%d\n", yrBirth, yrDeath);
-//for (ixAlive=0; ixAlive <= 100; ixAlive++)
-//{
-//    printf("[%3d]", ixAlive);
-//    for (int ix=0; ix < airBreathers[ixAlive]; ix++)
-//    {
-//        if (ix%10 == 1)
-//            printf("*");
-//    }
-//    printf("\n");
-//}
-
-
-
-            } // while() there are more people to read in
-            
-            if (fDoBreak)
-                break;
-            
-            int ixYear=0;
-            if (MaxYears.size() == 0)
-            {
-                cout << "There were no records to process in file '" << pFB->populationFile().c_str() << "'" << endl;
-                break;
-            }
-            
-            cout << endl;
-            if (MaxYears.size() == 1)
-                cout << "The year ";
-            else
-            {
-                cout << "The " << MaxYears.size() << " years ";
-            }
-            cout << "with the the highest population (" << maxAlive<< ") "<< ((MaxYears.size() == 1) ? "was:" : "were:") << endl;
-            cout << "{ "  ;
-            for (auto itMaxYr=MaxYears.begin(); itMaxYr!=MaxYears.end(); ++itMaxYr)
-            {
-                cout << (*itMaxYr + RANGE_YEAR_BEG)  << ((++ixYear == MaxYears.size()) ? " }\n\n" : ", ");
-            }
-        }
-        else
-        {
-            {
-                stringstream ss;
-                ss <<  "    Unable to open specified file,'" << pFB->populationFile().c_str() << "', for write." << endl;
-                pFB->addCmdLnArgsToErr(ss);
-                string strErr = ss.str();
-                pFB.get()->reportErr(strErr);
-            }
-        }
-    } while (false);
-}
-
-int main(int argc, const char * argv[])
-{
-    bool fDoBreak = false;
-    do
-    {
-        string strErr;
-        argsAndErrs fb;
-    
-        //--------------------------------------------------------------------------------------------
-        // Input and sanity check command line args
-        //--------------------------------------------------------------------------------------------
-        if (( fDoBreak = fb.initWithArgs(argc,  argv, strErr) ))
-        {
-            fb.reportErr(strErr);
-            break;
-        }
-        
-        //--------------------------------------------------------------------------------------------
-        // Do the work - Find combinations of orginal message after hidden message chars are removed
-        //--------------------------------------------------------------------------------------------
-        shared_ptr<argsAndErrs_t>spFB = make_shared<argsAndErrs_t>(fb);
-        
-        populationInfo myPeeps(spFB);
-        if (fb.needData())
-        {
-            // Make some babies and see how long they last
-            myPeeps.generateVitalStats();
-        }
-        //else
-        {
-            // Muster Call
-            myPeeps.findMaxPopulationYear();
-        }
-    } while (false);
-    
-    return 0;
-}
+//=========================================================================
+// Description:
+//    This program allows the user to
+//    a) Generate a population file, including the birth & death years of each person.
+//        The range of each person's life span is trimmed to be between 1900 and 2000, inclusively.
+//    b) Process the file and report the year that the maximum number of people were alive.
+//       If the maximum occurs in multile years, all years will be reported.
+//
+// Usage: SGI_WhosAlive populationFile [sizeOfPopulationToGenerate]
+//    Where
+//       'populationFile'             is the file to read from or write to ('-' reads stdin),
+//       'sizeOfPopulationToGenerate' is an integer specifying the number of records to generate for the file.
+//    If no population size is specified, simply read and process the populationFile.
+//
+// Usage: SGI_WhosAlive populationFile populationFile... [options]
+//    Counts every file (or glob), then reports each file and all of them together.
+//
+// Usage: SGI_WhosAlive populationFile --bench[=N,N...] [options]
+//    Times generating and counting populationFile across sizes, parsers, engines and thread counts; reports JSON.
+//=========================================================================
+
+
+#include <iostream>        // for cout
+#include <fstream>         // for ofstream,ifstream
+#include <sstream>         // for stringstream
+#include <time.h>          // for the default generator seed
+#include <assert.h>        // for assert
+#include <vector>          // for vector
+#include <list>            // for list
+#include <memory>          // for weak_ptr
+#include <algorithm>       // for min/max
+#include <limits>          // for numeric_limits
+#include <type_traits>     // for is_pod
+#include <stdint.h>        // for int32_t
+#include <thread>          // for thread
+#include <mutex>           // for mutex
+#include <condition_variable> // for condition_variable
+#include <atomic>          // for atomic
+#include <deque>           // for deque
+#include <functional>      // for function
+#include <queue>           // for priority_queue
+#include <unordered_map>   // for unordered_map (see populationStore)
+#include <chrono>          // for steady_clock (see --bench)
+#include <string.h>        // for memchr
+#include <stdio.h>         // for fopen, fread
+#include <stdlib.h>        // for malloc (see runStats)
+#include <new>             // for bad_alloc
+#include <stdexcept>       // for invalid_argument
+#ifndef _WIN32
+#include <fcntl.h>         // for open
+#include <unistd.h>        // for close
+#include <sys/stat.h>      // for fstat
+#include <sys/mman.h>      // for mmap
+#include <glob.h>          // for glob
+#include <sys/resource.h>  // for getrusage
+#else
+#include <io.h>            // for _setmode
+#include <fcntl.h>         // for _O_BINARY
+#endif
+#ifdef _WIN32
+#define fseek64 _fseeki64  // 64-bit file offsets
+#else
+#define fseek64 fseeko
+#endif
+#ifndef SGI_WITH_ZLIB
+#define SGI_WITH_ZLIB 0    // build with -DSGI_WITH_ZLIB=1 -lz to read and write gzip population files (see frameCodec)
+#endif
+#ifndef SGI_WITH_ZSTD
+#define SGI_WITH_ZSTD 0    // build with -DSGI_WITH_ZSTD=1 -lzstd to read and write zstd population files
+#endif
+#if SGI_WITH_ZLIB
+#include <zlib.h>          // for deflate, inflate
+#endif
+#if SGI_WITH_ZSTD
+#include <zstd.h>          // for ZSTD_compress, ZSTD_decompress
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>     // for the AVX2 yearScan kernels
+#define SGI_SCAN_AVX2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>      // for the NEON yearScan kernels
+#define SGI_SCAN_NEON 1
+#endif
+using namespace std;
+
+// Range, in years, of the population
+#define RANGE_YEAR_END (2000)
+#define RANGE_YEAR_BEG (1900)
+
+// Semi-Realistic Life Span constants
+#define MAX_AGE (130)
+#define RANGE_YEAR_MIN   (RANGE_YEAR_BEG-MAX_AGE+1)
+#define STDIN_FILE_NAME  "-"       // populationFile name that reads the population from stdin
+#define CHECKPOINT_FILE_EXT ".ckpt" // default --checkpoint file is populationFile + this
+#define MANIFEST_MAGIC   "#wia-shards 1" // first line of a manifest, the populationFile that lists its shards (see --shards)
+#define MAX_SHARDS       (10000)   // most shards --shards= writes
+#define MAX_YEAR         (9999)    // Last year --years= accepts (a binary header stores years in 16 bits)
+#define BENCH_SIZES      {100000, 1000000} // population sizes --bench generates and counts, unless --bench= lists them
+#define BENCH_REPEATS    (3)       // times each --bench case is run (the fastest is reported)
+#define SERVE_NAME_MATCHES (10)    // people whose years a --serve 'name' query lists
+#define RANGE_AGEAVG_END (90)      // Average person lives to somewhere in this range
+#define RANGE_AGEAVG_BEG (60)
+#define RANGE_AGEOUT_END (MAX_AGE) // Outliers live to somewhere in this range (overlaps Average range)
+#define RANGE_AGEOUT_BEG (40)
+#define RANGE_AGEMID_END (30)      // The invincible years (new drivers, drinking, ...) deaths happen somewhere in this range
+#define RANGE_AGEMID_BEG (16)
+#define RANGE_AGENEW_END (1)       // short-lived NewBorns live to somewhere in this range
+#define RANGE_AGENEW_BEG (0)
+#define RANGE_AGEBAD_END (RANGE_AGEOUT_END)    // BadLuck/Accidents can happen any time (overlaps all ranges)
+#define RANGE_AGEBAD_BEG (RANGE_AGENEW_BEG)
+
+// Every generated person has the same (redacted) names
+#define REDACTED_FIRST_NAME "<Name Redacted>"
+#define REDACTED_LAST_NAME  "<For Privacy>"
+
+//--------------------------------------------------------------------------
+// Name: struct _vitalStats()
+// Desc: container for personal info (years of birth & death); 4 bytes, plain old data.
+//       The names are not kept: generated people all share the redacted names, and counting never needs them.
+//--------------------------------------------------------------------------
+typedef struct _vitalStats
+{
+    // accessors
+    int      birthYear() const { return _yrBirth; }
+    int      deathYear() const { return _yrDeath; }
+
+    uint16_t _yrBirth; // RANGE_YEAR_BEG 'trimmed' year of birth (any year to MAX_YEAR fits in 16 bits)
+    uint16_t _yrDeath; // RANGE_YEAR_END 'trimmed' year of death
+} vitalStats_t;
+static_assert(sizeof(vitalStats_t) == 4 && is_pod<vitalStats_t>::value, "a generated person is 4 bytes of plain old data");
+
+//=========================================================================
+// Name:    struct _yearRange
+// Desc:
+//          range, in years, of the population (RANGE_YEAR_BEG to RANGE_YEAR_END, unless --years= or a binary header says otherwise)
+//=========================================================================
+typedef struct _yearRange
+{
+public:
+    _yearRange(int beg=RANGE_YEAR_BEG, int end=RANGE_YEAR_END) : yrBeg(beg), yrEnd(end) {}
+    int  width() const                          { return yrEnd - yrBeg + 1; }
+    bool operator!=(const _yearRange &o) const  { return yrBeg != o.yrBeg || yrEnd != o.yrEnd; }
+public:
+    int yrBeg;  // first year in range
+    int yrEnd;  // last  year in range
+} yearRange_t;
+
+//=========================================================================
+// Name:    class argsAndErrs
+// Desc:
+//          object for
+//          * accepting, sanity checking, and maintaining command line arguments
+//          * reporting errors
+//          * providing accessors to command line arguments and their derivatives
+//=========================================================================
+class argsAndErrs
+{
+public:
+public:
+    enum { eCmdLnArg_AppPath, eCmdLnArg_PopFile, eCmdLnArg_PopSize };
+    enum countEngine_t { eCountEngine_PerYear, eCountEngine_DiffArray };
+    enum argMax_t      { eArgMax_Inline, eArgMax_Deferred };
+    enum parser_t      { eParser_Tokens, eParser_Fast };
+    enum reader_t      { eReader_Stream, eReader_Buffered, eReader_Mmap, eReader_Async };
+    enum format_t      { eFormat_Text, eFormat_Binary };
+    enum generator_t   { eGenerator_Vector, eGenerator_Stream };
+    enum fused_t       { eFused_Off, eFused_Count, eFused_Tee };
+    enum stats_t       { eStats_Off, eStats_Text, eStats_Json };
+    enum compress_t    { eCompress_None, eCompress_Gzip, eCompress_Zstd };
+    enum onCorrupt_t   { eOnCorrupt_Stop, eOnCorrupt_Skip };
+    enum names_t       { eNames_Off, eNames_Intern, eNames_Copy };
+    enum checkpointVerify_t { eCheckpointVerify_Edges, eCheckpointVerify_Full };
+    argsAndErrs();
+    bool initWithArgs(int argc, const char * argv[], string &strErr);
+    void reportErr(string strErr="");
+    bool needData() { return (_sizeOfPopulation==-1) ? false : true; }
+    fused_t fused() { return _fused; }
+    bool bench() { return _fBench; }
+    stats_t stats() { return _stats; }
+    bool store() { return _fStore; }
+    names_t names() { return _names; }
+    bool serve() { return _fServe; }
+    friend class populationInfo; // needs access to protected functions
+protected:
+    void          addCmdLnArgsToErr(stringstream &ss);
+    bool          initOption(const string &strOpt, string &strErr);
+    void          addPopulationFiles(const string &strArg);
+    void          countShards();
+    static bool   readManifest(const string &strFile, vector<string> &shards);
+    static bool   parseYearRange(const string &strVal, yearRange_t &range);
+    long long     populationSize() { return _sizeOfPopulation; }
+    const string  populationFile() { return _filePopulation; }
+    countEngine_t countEngine()    { return _countEngine; }
+    argMax_t      argMax()         { return _argMax; }
+    parser_t      parser()         { return _parser; }
+    onCorrupt_t   onCorrupt()      { return _onCorrupt; }
+    reader_t      reader()         { return _reader; }
+    bool          fromStdin()      { return _filePopulation == STDIN_FILE_NAME; }
+    int           threadCount()    { return _cntThreads; }
+    format_t      format()         { return _format; }
+    generator_t   generator()      { return _generator; }
+    int           shardCount()     { return _cntShards; }
+    compress_t    compress()       { return _compress; }
+    unsigned long long seed()      { return _seed; }
+    const yearRange_t &yearRange() { return _yearRange; }
+    bool          yearRangeSet()   { return _fYearRangeSet; }
+    const vector<string> &populationFiles() { return _filesPopulation; }
+    const vector<long long> &benchSizes()   { return _benchSizes; }
+    size_t        topCount()       { return _cntTop; }
+    const string &histogramFile()  { return _fileHistogram; }
+    checkpointVerify_t checkpointVerify() { return _checkpointVerify; }
+    const string  checkpointFileFor(const string &strFile) { return !_fCheckpoint ? "" : _fileCheckpoint.size() ? _fileCheckpoint : strFile + CHECKPOINT_FILE_EXT; }
+
+private:
+    vector<string> _args;               // command line args
+    string         _filePopulation;     // CLA[1] - population file to use
+    long long      _sizeOfPopulation;   // CLA[2] - optional size of popuation -> generates file
+    countEngine_t  _countEngine;        // --engine=  - how findMaxPopulationYear() counts each person's alive years
+    argMax_t       _argMax;             // --argmax=  - when the peryear engine tracks the most populous year(s)
+    parser_t       _parser;             // --parser=  - how each record's years are decoded
+    onCorrupt_t    _onCorrupt;          // --on-corrupt= - whether counting stops at the first corrupt record, or skips (and samples) them all
+    reader_t       _reader;             // --reader=  - how populationFile is read
+    int            _cntThreads;         // --threads= - worker threads used to count the population
+    format_t       _format;             // --format=  - format of a generated populationFile
+    generator_t    _generator;          // --generator= - whether people are written as they are generated
+    compress_t     _compress;           // --compress= - compress a generated populationFile, as independently compressed frames
+    int            _cntShards;          // --shards=  - write the generated population as this many shard files, with populationFile their manifest; 0 - one file
+    unsigned long long _seed;           // --seed=    - seed of the generated population
+    fused_t        _fused;              // --fused    - count the generated population in memory (optionally still writing populationFile)
+    yearRange_t    _yearRange;          // --years=   - years that are generated and counted
+    bool           _fYearRangeSet;      // --years= was given (a binary header's years are used otherwise)
+    bool           _fCheckpoint;        // --checkpoint - resume counting from (and save) a sidecar checkpoint
+    string         _fileCheckpoint;     // --checkpoint= - the checkpoint file (default: populationFile + CHECKPOINT_FILE_EXT)
+    checkpointVerify_t _checkpointVerify; // --checkpoint-verify= - whether resuming checks the edges of the covered bytes, or hashes them all
+    vector<string> _filesPopulation;    // CLA[1..] - population files to count, when more than one is given (or a glob)
+    bool           _fBench;             // --bench    - time generating and counting populationFile across a matrix of options
+    vector<long long> _benchSizes;      // --bench=   - population sizes to benchmark
+    stats_t        _stats;              // --stats    - report where the time of the run went (see runStats)
+    bool           _fStore;             // --store    - load populationFile into memory (see populationStore), then count it
+    names_t        _names;              // --names    - keep each person's names in the populationStore (see nameArena)
+    bool           _fServe;             // --serve    - load populationFile into memory, then answer queries on stdin
+    size_t         _cntTop;             // --top=     - report this many of the most populous years; 0 - just the tied maxima
+    string         _fileHistogram;      // --histogram= - write the population of every year to this file (CSV, or binary for .bin)
+};
+typedef argsAndErrs argsAndErrs_t;
+
+#define DEFAULT_YEAR_WIDTH (RANGE_YEAR_END-RANGE_YEAR_BEG+1) // range width with compile-time specialized counting kernels
+
+//=========================================================================
+// Name:    class yearScan
+// Desc:
+//          kernels for yearCounter::finish()'s passes over the yearly counts
+//          * prefixSum() - diff engine's births/deaths deltas, in place, to the population of each year
+//          * maxOf()     - the largest count
+//          * findTies()  - every year with a given (non-zero) count
+//          Each has a scalar version, and AVX2 (x86, selected at run time, so the same binary runs on CPUs without it)
+//          and NEON (aarch64, always present) versions.
+//=========================================================================
+class yearScan
+{
+public:
+    static void      prefixSum(long long *pCnts, size_t cnt);
+    static long long maxOf(const long long *pCnts, size_t cnt);
+    static void      findTies(const long long *pCnts, size_t cnt, long long cntMax, list<long long> &ixTies);
+#if SGI_SCAN_AVX2
+    static bool      hasAvx2();          // also selects recordScan's kernel
+#endif
+private:
+    static void      prefixSumScalar(long long *pCnts, size_t cnt, long long cntCarry);
+    static long long maxOfScalar(const long long *pCnts, size_t cnt, long long cntMax);
+    static void      findTiesScalar(const long long *pCnts, size_t ixBeg, size_t cnt, long long cntMax, list<long long> &ixTies);
+#if SGI_SCAN_AVX2
+    static void      prefixSumAvx2(long long *pCnts, size_t cnt);
+    static long long maxOfAvx2(const long long *pCnts, size_t cnt);
+    static void      findTiesAvx2(const long long *pCnts, size_t cnt, long long cntMax, list<long long> &ixTies);
+#endif
+};
+
+void yearScan::prefixSumScalar(long long *pCnts, size_t cnt, long long cntCarry)
+{
+    for (size_t ix = 0; ix < cnt; ix++)
+    {
+        cntCarry  += pCnts[ix];
+        pCnts[ix]  = cntCarry;
+    }
+}
+
+long long yearScan::maxOfScalar(const long long *pCnts, size_t cnt, long long cntMax)
+{
+    for (size_t ix = 0; ix < cnt; ix++)
+        cntMax = max(cntMax, pCnts[ix]);
+    return cntMax;
+}
+
+void yearScan::findTiesScalar(const long long *pCnts, size_t ixBeg, size_t cnt, long long cntMax, list<long long> &ixTies)
+{
+    for (size_t ix = ixBeg; ix < cnt; ix++)
+    {
+        if (pCnts[ix] == cntMax)
+            ixTies.push_back(ix);
+    }
+}
+
+#if SGI_SCAN_AVX2
+//--------------------------------------------------------------------------
+// Name: hasAvx2()
+// Desc:
+//        whether this CPU supports AVX2 (checked once)
+// Params:
+//       <none>
+// Returns:
+//      true if the AVX2 kernels may be used
+//--------------------------------------------------------------------------
+bool yearScan::hasAvx2()
+{
+    static const bool fAvx2 = __builtin_cpu_supports("avx2");
+    return fAvx2;
+}
+
+__attribute__((target("avx2")))
+void yearScan::prefixSumAvx2(long long *pCnts, size_t cnt)
+{
+    const __m256i zero  = _mm256_setzero_si256();
+    __m256i       carry = zero;
+    size_t        ix    = 0;
+    for (; ix + 4 <= cnt; ix += 4)
+    {
+        // In-register scan of 4 lanes: add the lanes shifted up by 1, then by 2
+        __m256i v = _mm256_loadu_si256((const __m256i *)(pCnts + ix));
+        v = _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(2,1,0,0)), zero, 0x03));
+        v = _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(1,0,0,0)), zero, 0x0F));
+        v = _mm256_add_epi64(v, carry);
+        _mm256_storeu_si256((__m256i *)(pCnts + ix), v);
+        carry = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3,3,3,3));
+    }
+    prefixSumScalar(pCnts + ix, cnt - ix, ix ? pCnts[ix-1] : 0);
+}
+
+__attribute__((target("avx2")))
+long long yearScan::maxOfAvx2(const long long *pCnts, size_t cnt)
+{
+    if (cnt < 4)
+        return maxOfScalar(pCnts, cnt, 0);
+
+    // AVX2 has no 64-bit max; compare and blend instead
+    __m256i vMax = _mm256_loadu_si256((const __m256i *)pCnts);
+    size_t  ix   = 4;
+    for (; ix + 4 <= cnt; ix += 4)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(pCnts + ix));
+        vMax = _mm256_blendv_epi8(vMax, v, _mm256_cmpgt_epi64(v, vMax));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256((__m256i *)lanes, vMax);
+    return maxOfScalar(pCnts + ix, cnt - ix, maxOfScalar(lanes, 4, lanes[0]));
+}
+
+__attribute__((target("avx2")))
+void yearScan::findTiesAvx2(const long long *pCnts, size_t cnt, long long cntMax, list<long long> &ixTies)
+{
+    const __m256i vMax = _mm256_set1_epi64x(cntMax);
+    size_t        ix   = 0;
+    for (; ix + 4 <= cnt; ix += 4)
+    {
+        // One bit per lane that ties; usually none do
+        __m256i v     = _mm256_loadu_si256((const __m256i *)(pCnts + ix));
+        int     mTies = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, vMax)));
+        for (; mTies; mTies &= mTies - 1)
+            ixTies.push_back(ix + __builtin_ctz(mTies));
+    }
+    findTiesScalar(pCnts, ix, cnt, cntMax, ixTies);
+}
+#endif // SGI_SCAN_AVX2
+
+//--------------------------------------------------------------------------
+// Name: prefixSum()
+// Desc:
+//        replace each count with the sum of it and every count before it
+// Params:
+//       pCnts - counts
+//       cnt   - number of counts
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearScan::prefixSum(long long *pCnts, size_t cnt)
+{
+#if SGI_SCAN_AVX2
+    if (hasAvx2())
+        return prefixSumAvx2(pCnts, cnt);
+#elif SGI_SCAN_NEON
+    int64x2_t carry = vdupq_n_s64(0);
+    size_t    ix    = 0;
+    for (; ix + 2 <= cnt; ix += 2)
+    {
+        int64x2_t v = vld1q_s64(pCnts + ix);
+        v = vaddq_s64(v, vextq_s64(vdupq_n_s64(0), v, 1));
+        v = vaddq_s64(v, carry);
+        vst1q_s64(pCnts + ix, v);
+        carry = vdupq_laneq_s64(v, 1);
+    }
+    return prefixSumScalar(pCnts + ix, cnt - ix, ix ? pCnts[ix-1] : 0);
+#endif
+    prefixSumScalar(pCnts, cnt, 0);
+}
+
+//--------------------------------------------------------------------------
+// Name: maxOf()
+// Desc:
+//        the largest count
+// Params:
+//       pCnts - counts
+//       cnt   - number of counts
+// Returns:
+//      the largest count; 0 if it is smaller or there are none
+//--------------------------------------------------------------------------
+long long yearScan::maxOf(const long long *pCnts, size_t cnt)
+{
+#if SGI_SCAN_AVX2
+    if (hasAvx2())
+        return max(0LL, maxOfAvx2(pCnts, cnt));
+#elif SGI_SCAN_NEON
+    int64x2_t vMax = vdupq_n_s64(0);
+    size_t    ix   = 0;
+    for (; ix + 2 <= cnt; ix += 2)
+    {
+        int64x2_t v = vld1q_s64(pCnts + ix);
+        vMax = vbslq_s64(vcgtq_s64(v, vMax), v, vMax);
+    }
+    return maxOfScalar(pCnts + ix, cnt - ix, max(vgetq_lane_s64(vMax, 0), vgetq_lane_s64(vMax, 1)));
+#endif
+    return maxOfScalar(pCnts, cnt, 0);
+}
+
+//--------------------------------------------------------------------------
+// Name: findTies()
+// Desc:
+//        append the index of every count equal to cntMax, in order
+// Params:
+//       pCnts  - counts
+//       cnt    - number of counts
+//       cntMax - the count to find (0 finds nothing; empty years are not ties)
+//       ixTies - the indexes are appended to this
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearScan::findTies(const long long *pCnts, size_t cnt, long long cntMax, list<long long> &ixTies)
+{
+    if (cntMax == 0)
+        return;
+#if SGI_SCAN_AVX2
+    if (hasAvx2())
+        return findTiesAvx2(pCnts, cnt, cntMax, ixTies);
+#elif SGI_SCAN_NEON
+    const int64x2_t vMax = vdupq_n_s64(cntMax);
+    size_t          ix   = 0;
+    for (; ix + 2 <= cnt; ix += 2)
+    {
+        uint64x2_t mTies = vceqq_s64(vld1q_s64(pCnts + ix), vMax);
+        if (vgetq_lane_u64(mTies, 0)) ixTies.push_back(ix);
+        if (vgetq_lane_u64(mTies, 1)) ixTies.push_back(ix+1);
+    }
+    return findTiesScalar(pCnts, ix, cnt, cntMax, ixTies);
+#endif
+    findTiesScalar(pCnts, 0, cnt, cntMax, ixTies);
+}
+
+//=========================================================================
+// Name:    class recordScan
+// Desc:
+//          structural index of a block of text records, for populationInfo::countIndexedRecords()
+//          * available() - whether this CPU has an index() kernel; otherwise countRecords() memchr()s each record
+//          * index()     - for each 64 byte window, a bit per byte that is the delimiter, and per byte that is a newline
+//          Like yearScan, the AVX2 kernel (x86) is selected at run time, and the NEON kernel (aarch64) is always present.
+//=========================================================================
+class recordScan
+{
+public:
+    #define SCAN_WINDOW_BYTES  (64)   // bytes per index() mask
+    #define SCAN_BATCH_WINDOWS (64)   // windows indexed at once (4KB; the masks stay in L1)
+
+    static bool      available();
+    static void      index(const char *p, size_t cntWindows, char delim, uint64_t *pDelims, uint64_t *pNewlines);
+private:
+#if SGI_SCAN_AVX2
+    static void      indexAvx2(const char *p, size_t cntWindows, char delim, uint64_t *pDelims, uint64_t *pNewlines);
+#elif SGI_SCAN_NEON
+    static uint64_t  maskNeon(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3);
+#endif
+};
+
+//--------------------------------------------------------------------------
+// Name: available()
+// Desc:
+//        whether index() has a vector kernel on this CPU
+// Params:
+//       <none>
+// Returns:
+//      true if index() may be called
+//--------------------------------------------------------------------------
+bool recordScan::available()
+{
+#if SGI_SCAN_AVX2
+    return yearScan::hasAvx2();
+#elif SGI_SCAN_NEON
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if SGI_SCAN_AVX2
+__attribute__((target("avx2")))
+void recordScan::indexAvx2(const char *p, size_t cntWindows, char delim, uint64_t *pDelims, uint64_t *pNewlines)
+{
+    const __m256i vDelim   = _mm256_set1_epi8(delim);
+    const __m256i vNewline = _mm256_set1_epi8('\n');
+    for (size_t ixWin = 0; ixWin < cntWindows; ixWin++, p += SCAN_WINDOW_BYTES)
+    {
+        // 32 bytes per compare; movemask packs a bit per byte
+        __m256i lo = _mm256_loadu_si256((const __m256i *)p);
+        __m256i hi = _mm256_loadu_si256((const __m256i *)(p + 32));
+        pDelims[ixWin]   = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, vDelim))
+                         | ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, vDelim)) << 32);
+        pNewlines[ixWin] = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, vNewline))
+                         | ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, vNewline)) << 32);
+    }
+}
+#elif SGI_SCAN_NEON
+uint64_t recordScan::maskNeon(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3)
+{
+    // NEON has no movemask: keep a distinct bit per byte, then add neighbouring bytes together until 64 bits remain
+    static const uint8_t bits[16] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+    const uint8x16_t vBits = vld1q_u8(bits);
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, vBits), vandq_u8(m1, vBits));
+    uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, vBits), vandq_u8(m3, vBits));
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+#endif
+
+//--------------------------------------------------------------------------
+// Name: index()
+// Desc:
+//        index the delimiters and newlines of whole windows; bit n of a mask is byte n of its window.
+//        Only call if available().
+// Params:
+//       p          - first char of the first window
+//       cntWindows - number of SCAN_WINDOW_BYTES windows to index (all of them must be readable)
+//       delim      - the intra-record delimiter
+//       pDelims    - a mask per window of its delimiters
+//       pNewlines  - a mask per window of its newlines
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void recordScan::index(const char *p, size_t cntWindows, char delim, uint64_t *pDelims, uint64_t *pNewlines)
+{
+#if SGI_SCAN_AVX2
+    indexAvx2(p, cntWindows, delim, pDelims, pNewlines);
+#elif SGI_SCAN_NEON
+    const uint8x16_t vDelim   = vdupq_n_u8((uint8_t)delim);
+    const uint8x16_t vNewline = vdupq_n_u8('\n');
+    for (size_t ixWin = 0; ixWin < cntWindows; ixWin++, p += SCAN_WINDOW_BYTES)
+    {
+        uint8x16_t v0 = vld1q_u8((const uint8_t *)p);
+        uint8x16_t v1 = vld1q_u8((const uint8_t *)p + 16);
+        uint8x16_t v2 = vld1q_u8((const uint8_t *)p + 32);
+        uint8x16_t v3 = vld1q_u8((const uint8_t *)p + 48);
+        pDelims[ixWin]   = maskNeon(vceqq_u8(v0, vDelim),   vceqq_u8(v1, vDelim),   vceqq_u8(v2, vDelim),   vceqq_u8(v3, vDelim));
+        pNewlines[ixWin] = maskNeon(vceqq_u8(v0, vNewline), vceqq_u8(v1, vNewline), vceqq_u8(v2, vNewline), vceqq_u8(v3, vNewline));
+    }
+#else
+    (void)p; (void)cntWindows; (void)delim; (void)pDelims; (void)pNewlines;
+    assert(false);   // not available()
+#endif
+}
+
+//=========================================================================
+// Name:    class yearCounter
+// Desc:
+//          population count of each year in range
+//          * addPerson() - adds a person's alive years, per the selected countEngine_t
+//          * finish()    - after the last person: finalizes the counts and finds the most populous year(s)
+//          The hot counting loops count into a yearBins<> first; see addBins().
+//=========================================================================
+class yearCounter
+{
+public:
+    yearCounter(const yearRange_t &range, argsAndErrs::countEngine_t countEngine, argsAndErrs::argMax_t argMax)
+      : _range(range),
+        _airBreathers(range.width()+1, 0), // One extra slot, so the diff engine can record the -1 after a yrEnd death
+        _maxAlive(0),
+        _fDiff(countEngine == argsAndErrs::eCountEngine_DiffArray),
+        _fArgMaxInline(!_fDiff && argMax == argsAndErrs::eArgMax_Inline) {}
+
+    inline void addPerson(int yrBirth, int yrDeath);
+    template <typename COUNT_T>
+    void        addBins(const COUNT_T *pBins);
+    void        merge(const yearCounter &other);
+    void        finish();
+    void        topYears(size_t cntTop, vector<long long> &ixYears) const;
+
+    // accessors
+    const yearRange_t     &range()         const { return _range; }
+    int                    width()         const { return _range.width(); }
+    bool                   isDiff()        const { return _fDiff; }
+    bool                   isArgMaxInline() const { return _fArgMaxInline; }
+    const vector<long long> &counts()      const { return _airBreathers; } // raw counts, before finish(); the population of each year, after
+    long long              maxAlive()  { return _maxAlive; }
+    const list<long long> &maxYears()  { return _maxYears; } // offsets from range().yrBeg
+private:
+    yearRange_t       _range;           // years counted
+    vector<long long> _airBreathers;    // population (or, for the diff engine, change in population) of each year
+    list<long long>   _maxYears;        // the year(s) with the most people alive
+    long long         _maxAlive;        // the most people alive in any year
+    bool              _fDiff;           // eCountEngine_DiffArray
+    bool              _fArgMaxInline;   // eCountEngine_PerYear and eArgMax_Inline
+};
+
+//--------------------------------------------------------------------------
+// Name: addPerson()
+// Desc:
+//        Add this person's alive years to the population count
+// Params:
+//       yrBirth - year of birth (range().yrBeg to range().yrEnd)
+//       yrDeath - year of death (yrBirth to range().yrEnd)
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+inline void yearCounter::addPerson(int yrBirth, int yrDeath)
+{
+    int ixAlive  = yrBirth - _range.yrBeg;
+    int lastYear = yrDeath - _range.yrBeg;
+    if (_fDiff)
+    {
+        // Only mark the change in population; the years are summed by finish()
+        ++_airBreathers[ixAlive];
+        --_airBreathers[lastYear+1];
+        return;
+    }
+    if (!_fArgMaxInline)
+    {
+        // Only count; the most populous year(s) are found by finish()
+        for (; ixAlive <= lastYear; ixAlive++)
+            ++_airBreathers[ixAlive];
+        return;
+    }
+    for (; ixAlive <= lastYear; ixAlive++)
+    {
+        long long cntAlive = ++_airBreathers[ixAlive]; // this person is alive this year
+
+        if (cntAlive > _maxAlive)
+        {
+            // This year now has the largest population
+            _maxYears.clear();
+            _maxYears.push_back(ixAlive);
+            _maxAlive = cntAlive;
+        }
+        else if (cntAlive == _maxAlive)
+        {
+            _maxYears.push_back(ixAlive);
+        }
+    } // for each year that the person is alive
+}
+
+//--------------------------------------------------------------------------
+// Name: addBins()
+// Desc:
+//        Add counts, made with the same countEngine_t and range, to this counter.
+//        The most populous year(s) will then be found by finish().
+// Params:
+//       pBins - width()+1 counts, of any (signed) width
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+template <typename COUNT_T>
+void yearCounter::addBins(const COUNT_T *pBins)
+{
+    for (size_t ixAlive=0; ixAlive < _airBreathers.size(); ixAlive++)
+        _airBreathers[ixAlive] += pBins[ixAlive];
+    _fArgMaxInline = false;
+}
+
+//--------------------------------------------------------------------------
+// Name: merge()
+// Desc:
+//        Add another counter's people (counted with the same countEngine_t and range) to this one.
+//        The most populous year(s) will then be found by finish().
+// Params:
+//       other - the counter to add
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearCounter::merge(const yearCounter &other)
+{
+    addBins(other._airBreathers.data());
+}
+
+//--------------------------------------------------------------------------
+// Name: finish()
+// Desc:
+//        Called after the last person has been added.
+//        Sums the diff engine's changes, then finds the most populous year(s) (unless already found inline)
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearCounter::finish()
+{
+    size_t cntYears = _range.width();
+    if (_fDiff)
+    {
+        // Single prefix-sum pass turns the births/deaths deltas into the population of each year
+        yearScan::prefixSum(_airBreathers.data(), cntYears);
+    }
+    if (!_fArgMaxInline)
+    {
+        // Deferred argmax: one scan for the maximum, one for all of its tied years
+        _maxAlive = yearScan::maxOf(_airBreathers.data(), cntYears);
+        _maxYears.clear();
+        yearScan::findTies(_airBreathers.data(), cntYears, _maxAlive, _maxYears);
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: topYears()
+// Desc:
+//        Called after finish(). Finds the cntTop most populous years, with a bounded heap of the cntTop best years
+//        seen so far, in one scan of the yearly counts.
+// Params:
+//       cntTop  - number of years to find (all of them, if there are fewer)
+//       ixYears - the years (offsets from range().yrBeg), most people alive first; ties, earliest year first
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearCounter::topYears(size_t cntTop, vector<long long> &ixYears) const
+{
+    // The heap's top is the worst year kept: the fewest alive, latest year
+    typedef pair<long long, long long> year_t; // (people alive, -year)
+    priority_queue<year_t, vector<year_t>, greater<year_t>> best;
+    size_t cntYears = _range.width();
+    for (size_t ixYear = 0; ixYear < cntYears && cntTop; ixYear++)
+    {
+        year_t year(_airBreathers[ixYear], -(long long)ixYear);
+        if (best.size() < cntTop)
+            best.push(year);
+        else if (best.top() < year)
+        {
+            best.pop();
+            best.push(year);
+        }
+    }
+
+    ixYears.resize(best.size());
+    for (size_t ixTop = best.size(); ixTop-- > 0; best.pop())
+        ixYears[ixTop] = -best.top().second;
+}
+
+//=========================================================================
+// Name:    class yearBins
+// Desc:
+//          counts of a hot counting loop (see populationInfo::countRecords()), added to a yearCounter by flush().
+//          WIDTH is the number of years in range, fixed at compile time, so the counts live on the stack
+//          and the loops over them are unrolled (see DEFAULT_YEAR_WIDTH).
+//          WIDTH 0 is any other range: the counts are sized at run time, on the heap.
+//          COUNT_T is a narrow (signed) count, so the bins stay in L1 for wide ranges (binCount_t by default).
+//          Each person moves any one count by at most 1, so addPerson() flushes to the 64-bit counter
+//          after numeric_limits<COUNT_T>::max() people; a narrow count can never overflow.
+//=========================================================================
+typedef int32_t binCount_t;
+
+template <int WIDTH, typename COUNT_T>
+struct yearBinStore
+{
+    yearBinStore(int /*width*/) { memset(bins, 0, sizeof(bins)); }
+    COUNT_T   *data()           { return bins; }
+    int        width() const    { return WIDTH; }
+    COUNT_T    bins[WIDTH+1];
+};
+
+template <typename COUNT_T>
+struct yearBinStore<0, COUNT_T>
+{
+    yearBinStore(int width) : bins(width+1, 0) {}
+    COUNT_T   *data()           { return bins.data(); }
+    int        width() const    { return (int)bins.size() - 1; }
+    vector<COUNT_T> bins;
+};
+
+template <int WIDTH, typename COUNT_T = binCount_t>
+class yearBins
+{
+public:
+    yearBins(yearCounter &counter) : _counter(counter), _store(counter.width()), _fDiff(counter.isDiff()), _cntUntilFlush(eMaxPeople) {}
+
+    //----------------------------------------------------------------------
+    // Name: addPerson()
+    // Desc: Add this person's alive years, as offsets from the range's first year (0 <= ixBirth <= ixDeath < width)
+    //----------------------------------------------------------------------
+    inline void addPerson(int ixBirth, int ixDeath)
+    {
+        COUNT_T *pBins = _store.data();
+        if (_fDiff)
+        {
+            ++pBins[ixBirth];
+            --pBins[ixDeath+1];
+        }
+        else
+        {
+            for (int ixAlive = ixBirth; ixAlive <= ixDeath; ixAlive++)
+                ++pBins[ixAlive];
+        }
+        if (--_cntUntilFlush == 0)
+            flush();
+    }
+
+    //----------------------------------------------------------------------
+    // Name: flush()
+    // Desc: Add the counts to the counter, and start over
+    //----------------------------------------------------------------------
+    void flush()
+    {
+        _counter.addBins(_store.data());
+        memset(_store.data(), 0, (_store.width()+1) * sizeof(COUNT_T));
+        _cntUntilFlush = eMaxPeople;
+    }
+private:
+    enum : long long { eMaxPeople = numeric_limits<COUNT_T>::max() }; // people that fit, whatever years they were alive
+    yearCounter                  &_counter;         // where flush() adds the counts
+    yearBinStore<WIDTH, COUNT_T>  _store;           // counts, as per yearCounter
+    bool                          _fDiff;           // eCountEngine_DiffArray
+    long long                     _cntUntilFlush;   // people that can still be added before the counts could overflow
+};
+
+//=========================================================================
+// Name:    class nameArena
+// Desc:
+//          the names kept by a populationStore (see --names): the chars of every name, back to back in one buffer,
+//          that each person references by offset and length (a nameRef_t), rather than a string (and its allocation)
+//          per name.
+//          * add()  - a name; when interning, a name already in the arena is referenced, not added again
+//          * find() - the reference of an interned name, if it is in the arena
+//          * data() - the chars of a name
+//          Interning hashes each name into an open addressing table of the distinct names' references.
+//=========================================================================
+struct nameRef_t
+{
+    bool operator==(const nameRef_t &ref) const { return off == ref.off && cnt == ref.cnt; }
+
+    uint64_t off : 40;  // offset of the name's chars in the arena
+    uint64_t cnt : 24;  // number of chars; 0 - no name (and no chars)
+};
+static_assert(sizeof(nameRef_t) == 8, "a name reference is 8 bytes");
+
+class nameArena
+{
+public:
+    #define NAME_MAX_CHARS   ((1 << 24) - 1)   // longest name kept; a longer one is cut to this
+    #define NAME_TABLE_SLOTS (1 << 10)         // initial slots of the intern table; it doubles at half full
+
+    nameArena(bool fIntern=true) : _fIntern(fIntern), _cntDistinct(0) {}
+    nameRef_t   add(const char *p, size_t cnt);
+    bool        find(const char *p, size_t cnt, nameRef_t &ref) const;
+    const char *data(const nameRef_t &ref) const { return _chars.data() + ref.off; }
+
+    // accessors
+    bool        interned() const { return _fIntern; }
+    size_t      bytes()    const { return _chars.size(); }   // chars of the names kept
+    size_t      distinct() const { return _cntDistinct; }     // names in the intern table
+private:
+    static uint64_t hash(const char *p, size_t cnt);
+    size_t          slotOf(const char *p, size_t cnt) const;
+    void            grow();
+private:
+    bool              _fIntern;      // each distinct name is kept once
+    vector<char>      _chars;        // the chars of every name kept
+    vector<nameRef_t> _slots;        // intern table: each distinct name, at (or after) its hash; cnt 0 - free
+    size_t            _cntDistinct;  // slots in use
+};
+
+//--------------------------------------------------------------------------
+// Name: hash()
+// Desc:
+//        FNV-1a hash of a name
+// Params:
+//       p   - first char of the name
+//       cnt - number of chars
+// Returns:
+//      the hash
+//--------------------------------------------------------------------------
+uint64_t nameArena::hash(const char *p, size_t cnt)
+{
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t ix = 0; ix < cnt; ix++)
+        h = (h ^ (unsigned char)p[ix]) * 1099511628211ULL;
+    return h;
+}
+
+//--------------------------------------------------------------------------
+// Name: slotOf()
+// Desc:
+//        the intern table slot of a name: the slot that references it, or the free slot it would go in
+// Params:
+//       p   - first char of the name
+//       cnt - number of chars (not 0)
+// Returns:
+//      index of the slot
+//--------------------------------------------------------------------------
+size_t nameArena::slotOf(const char *p, size_t cnt) const
+{
+    size_t mask = _slots.size() - 1;
+    for (size_t ixSlot = (size_t)hash(p, cnt) & mask; ; ixSlot = (ixSlot + 1) & mask)
+    {
+        const nameRef_t &slot = _slots[ixSlot];
+        if (slot.cnt == 0 || (slot.cnt == cnt && memcmp(data(slot), p, cnt) == 0))
+            return ixSlot;
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: grow()
+// Desc:
+//        double the intern table (or create it), and rehash the distinct names into it
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void nameArena::grow()
+{
+    vector<nameRef_t> slots;
+    slots.swap(_slots);
+    _slots.assign(slots.empty() ? NAME_TABLE_SLOTS : slots.size() * 2, nameRef_t{ 0, 0 });
+    for (auto &slot : slots)
+    {
+        if (slot.cnt)
+            _slots[slotOf(data(slot), slot.cnt)] = slot;
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: add()
+// Desc:
+//        keep a name
+// Params:
+//       p   - first char of the name
+//       cnt - number of chars (cut to NAME_MAX_CHARS)
+// Returns:
+//      the name's reference; an empty name has no chars
+//--------------------------------------------------------------------------
+nameRef_t nameArena::add(const char *p, size_t cnt)
+{
+    cnt = min(cnt, (size_t)NAME_MAX_CHARS);
+    if (cnt == 0)
+        return nameRef_t{ 0, 0 };
+    if (!_fIntern)
+    {
+        nameRef_t ref = { _chars.size(), cnt };
+        _chars.insert(_chars.end(), p, p + cnt);
+        return ref;
+    }
+
+    if ((_cntDistinct + 1) * 2 > _slots.size())
+        grow();
+    nameRef_t &slot = _slots[slotOf(p, cnt)];
+    if (slot.cnt == 0)
+    {
+        slot = nameRef_t{ _chars.size(), cnt };
+        _chars.insert(_chars.end(), p, p + cnt);
+        _cntDistinct++;
+    }
+    return slot;
+}
+
+//--------------------------------------------------------------------------
+// Name: find()
+// Desc:
+//        the reference of an interned name; with interning, people share a name exactly when they share its reference
+// Params:
+//       p   - first char of the name
+//       cnt - number of chars
+//       ref - the name's reference
+// Returns:
+//      true if the name is in the arena (an empty name always is); false if no one has it
+//--------------------------------------------------------------------------
+bool nameArena::find(const char *p, size_t cnt, nameRef_t &ref) const
+{
+    assert(_fIntern);
+    ref = nameRef_t{ 0, 0 };
+    if (cnt == 0)
+        return true;
+    if (_slots.empty() || cnt > NAME_MAX_CHARS)
+        return false;
+    ref = _slots[slotOf(p, cnt)];
+    return ref.cnt != 0;
+}
+
+//=========================================================================
+// Name:    class populationStore
+// Desc:
+//          the population, in memory, as a structure of arrays: a contiguous column of birth year offsets and one of
+//          death year offsets (from range().yrBeg), 2 bytes each per person.
+//          It is loaded once, from a text or binary population file (see populationInfo::loadStore()), and counted
+//          (or queried) any number of times without parsing the file again.
+//          With --names, each person's first and last names are two more columns, of references into a nameArena.
+//          * addPerson() - append a person (with names, when they are kept)
+//          * removePerson() - remove a person (the people are in no particular order), in O(log n): the first removal
+//                             indexes the people by their years of birth and death, and the index is kept from then on
+//          * countInto() - add every person to a yearCounter
+//          * findNamed() - the people with a first and last name
+//=========================================================================
+class populationStore
+{
+public:
+    populationStore(const yearRange_t &range=yearRange_t(), argsAndErrs::names_t names=argsAndErrs::eNames_Off)
+        : _range(range), _fNames(names != argsAndErrs::eNames_Off), _names(names == argsAndErrs::eNames_Intern), _fIndexed(false) {}
+    inline void addPerson(int yrBirth, int yrDeath) { _ixBirths.push_back((uint16_t)(yrBirth - _range.yrBeg)); _ixDeaths.push_back((uint16_t)(yrDeath - _range.yrBeg));
+                                                      if (_fNames) { _firstNames.push_back(nameRef_t{ 0, 0 }); _lastNames.push_back(nameRef_t{ 0, 0 }); }
+                                                      if (_fIndexed) indexLast(); }
+    inline void addPerson(int yrBirth, int yrDeath, const char *pFirst, size_t cntFirst, const char *pLast, size_t cntLast);
+    void        reserve(size_t cnt)                 { _ixBirths.reserve(cnt); _ixDeaths.reserve(cnt); }
+    bool        removePerson(int yrBirth, int yrDeath);
+    void        countInto(yearCounter &counter) const;
+    void        countBornInto(yearCounter &counter, const yearRange_t &born) const;
+    size_t      findNamed(const string &strFirst, const string &strLast, size_t cntMax, vector<size_t> &ixPeople) const;
+
+    // accessors
+    const yearRange_t &range()  const { return _range; }
+    size_t             size()   const { return _ixBirths.size(); }
+    const uint16_t    *births() const { return _ixBirths.data(); } // offsets from range().yrBeg
+    const uint16_t    *deaths() const { return _ixDeaths.data(); }
+    bool               hasNames() const { return _fNames; }
+    const nameArena   &names()  const { return _names; }
+private:
+    template <int WIDTH>
+    void countBins(yearCounter &counter) const;
+    static uint32_t keyOf(int ixBirth, int ixDeath) { return ((uint32_t)ixBirth << 16) | (uint16_t)ixDeath; }
+    void        indexLast();
+private:
+    yearRange_t       _range;      // years of the people (MAX_YEAR fits a 16 bit offset)
+    vector<uint16_t>  _ixBirths;   // year of birth of each person, as an offset from _range.yrBeg
+    vector<uint16_t>  _ixDeaths;   // year of death of each person, as an offset from _range.yrBeg
+    bool              _fNames;     // the names are kept (--names)
+    nameArena         _names;      // the chars of the names
+    vector<nameRef_t> _firstNames; // first name of each person, when the names are kept
+    vector<nameRef_t> _lastNames;  // last name of each person
+    bool              _fIndexed;   // _byYears is kept (from the first removePerson() on)
+    unordered_map<uint32_t, vector<size_t>> _byYears; // keyOf() birth and death -> the people born and died then, as a max-heap
+};
+
+//--------------------------------------------------------------------------
+// Name: addPerson()
+// Desc:
+//        append a person, and their names (if the names are kept)
+// Params:
+//       yrBirth  - year of birth
+//       yrDeath  - year of death
+//       pFirst   - first char of the first name
+//       cntFirst - number of chars of the first name
+//       pLast    - first char of the last name
+//       cntLast  - number of chars of the last name
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+inline void populationStore::addPerson(int yrBirth, int yrDeath, const char *pFirst, size_t cntFirst, const char *pLast, size_t cntLast)
+{
+    _ixBirths.push_back((uint16_t)(yrBirth - _range.yrBeg));
+    _ixDeaths.push_back((uint16_t)(yrDeath - _range.yrBeg));
+    if (_fNames)
+    {
+        _firstNames.push_back(_names.add(pFirst, cntFirst));
+        _lastNames.push_back(_names.add(pLast, cntLast));
+    }
+    if (_fIndexed)
+        indexLast();
+}
+
+//--------------------------------------------------------------------------
+// Name: indexLast()
+// Desc:
+//        add the last person to the index of the people by their years (see removePerson())
+// Params:
+//       none
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationStore::indexLast()
+{
+    vector<size_t> &people = _byYears[keyOf(_ixBirths.back(), _ixDeaths.back())];
+    people.push_back(size() - 1);
+    push_heap(people.begin(), people.end());
+}
+
+//--------------------------------------------------------------------------
+// Name: findNamed()
+// Desc:
+//        find the people with a first and last name. Interned names are matched by their references alone;
+//        otherwise by their chars.
+// Params:
+//       strFirst - first name
+//       strLast  - last name
+//       cntMax   - most people listed in ixPeople
+//       ixPeople - the first cntMax of the people, in store order
+// Returns:
+//      number of people with the names; 0 if the names are not kept
+//--------------------------------------------------------------------------
+size_t populationStore::findNamed(const string &strFirst, const string &strLast, size_t cntMax, vector<size_t> &ixPeople) const
+{
+    size_t cntFound = 0;
+    if (!_fNames)
+        return cntFound;
+
+    nameRef_t refFirst;
+    nameRef_t refLast;
+    bool      fIntern  = _names.interned();
+    auto      sameName = [&](const nameRef_t &ref, const string &strName)
+    {
+        return ref.cnt == strName.size() && (ref.cnt == 0 || memcmp(_names.data(ref), strName.data(), ref.cnt) == 0);
+    };
+    if (fIntern && (!_names.find(strFirst.data(), strFirst.size(), refFirst) || !_names.find(strLast.data(), strLast.size(), refLast)))
+        return cntFound;
+    for (size_t ixPerson = 0; ixPerson < size(); ixPerson++)
+    {
+        const nameRef_t &first = _firstNames[ixPerson];
+        const nameRef_t &last  = _lastNames[ixPerson];
+        if (fIntern ? !(first == refFirst && last == refLast) : !(sameName(first, strFirst) && sameName(last, strLast)))
+            continue;
+        if (cntFound++ < cntMax)
+            ixPeople.push_back(ixPerson);
+    }
+    return cntFound;
+}
+
+//--------------------------------------------------------------------------
+// Name: removePerson()
+// Desc:
+//        remove a person born and died in these years: the last of them in the store, found in _byYears rather than
+//        by a scan. The last person in the store is moved into its place; it is the last of its own years' people,
+//        so the top of their heap, and is repositioned there in O(log n).
+// Params:
+//       yrBirth - year of birth
+//       yrDeath - year of death
+// Returns:
+//      false if success; true if there is no such person
+//--------------------------------------------------------------------------
+bool populationStore::removePerson(int yrBirth, int yrDeath)
+{
+    if (!_fIndexed)
+    {
+        for (size_t ixPerson = 0; ixPerson < size(); ixPerson++)
+            _byYears[keyOf(_ixBirths[ixPerson], _ixDeaths[ixPerson])].push_back(ixPerson);
+        for (auto &years : _byYears)
+            make_heap(years.second.begin(), years.second.end());
+        _fIndexed = true;
+    }
+
+    auto itPeople = _byYears.find(keyOf(yrBirth - _range.yrBeg, yrDeath - _range.yrBeg));
+    if (itPeople == _byYears.end())
+        return true;
+    vector<size_t> &people = itPeople->second;
+    pop_heap(people.begin(), people.end());
+    size_t ixPerson = people.back();
+    people.pop_back();
+    if (people.empty())
+        _byYears.erase(itPeople);
+
+    size_t ixLast = size() - 1;
+    if (ixPerson != ixLast)
+    {
+        vector<size_t> &moved = _byYears[keyOf(_ixBirths[ixLast], _ixDeaths[ixLast])];
+        pop_heap(moved.begin(), moved.end());
+        moved.back() = ixPerson;
+        push_heap(moved.begin(), moved.end());
+
+        _ixBirths[ixPerson] = _ixBirths[ixLast];
+        _ixDeaths[ixPerson] = _ixDeaths[ixLast];
+        if (_fNames)
+        {
+            // The names' chars stay in the arena (another person may share them)
+            _firstNames[ixPerson] = _firstNames[ixLast];
+            _lastNames[ixPerson]  = _lastNames[ixLast];
+        }
+    }
+    _ixBirths.pop_back();
+    _ixDeaths.pop_back();
+    if (_fNames)
+    {
+        _firstNames.pop_back();
+        _lastNames.pop_back();
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: countInto()
+// Desc:
+//        add every person to the counter (of the same range), with the compile-time specialized kernel for its width,
+//        if there is one
+// Params:
+//       counter - population counts to add the people to
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationStore::countInto(yearCounter &counter) const
+{
+    if (counter.isArgMaxInline())
+    {
+        // tracks the maximum on every increment; can't use bins
+        for (size_t ixPerson = 0; ixPerson < size(); ixPerson++)
+            counter.addPerson(_range.yrBeg + _ixBirths[ixPerson], _range.yrBeg + _ixDeaths[ixPerson]);
+        return;
+    }
+    if (counter.width() == DEFAULT_YEAR_WIDTH)
+        countBins<DEFAULT_YEAR_WIDTH>(counter);
+    else
+        countBins<0>(counter);
+}
+
+//--------------------------------------------------------------------------
+// Name: countBornInto()
+// Desc:
+//        add the people born in some years to the counter (of the same range)
+// Params:
+//       counter - population counts to add the people to
+//       born    - years of birth of the people to add
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationStore::countBornInto(yearCounter &counter, const yearRange_t &born) const
+{
+    yearBins<0> bins(counter);
+    int ixBornBeg = born.yrBeg - _range.yrBeg;
+    int ixBornEnd = born.yrEnd - _range.yrBeg;
+    for (size_t ixPerson = 0; ixPerson < size(); ixPerson++)
+    {
+        int ixBirth = _ixBirths[ixPerson];
+        if (ixBirth >= ixBornBeg && ixBirth <= ixBornEnd)
+            bins.addPerson(ixBirth, _ixDeaths[ixPerson]);
+    }
+    bins.flush();
+}
+
+//--------------------------------------------------------------------------
+// Name: countBins()
+// Desc:
+//        add every person to the counter's bins (see countInto()).
+//        The diff engine's +1s and -1s are each a histogram of one column: both columns are read 4 people at a time,
+//        into 4 interleaved copies of the bins, so people born (or dying) in the same year don't wait on each other's
+//        increment of one count. The copies are summed into the counter every STORE_CHUNK_PEOPLE people (or fewer, so
+//        the sum fits a binCount_t).
+// Params:
+//       counter - population counts to add the people to
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+template <int WIDTH>
+void populationStore::countBins(yearCounter &counter) const
+{
+    #define STORE_LANES        (4)        // interleaved copies of the bins
+    #define STORE_CHUNK_PEOPLE (1 << 24)  // most people counted between flushes (fewer, if binCount_t is narrower)
+
+    const uint16_t *pBirths = _ixBirths.data();
+    const uint16_t *pDeaths = _ixDeaths.data();
+    size_t          cnt     = size();
+    if (!counter.isDiff())
+    {
+        yearBins<WIDTH> bins(counter);
+        for (size_t ixPerson = 0; ixPerson < cnt; ixPerson++)
+            bins.addPerson(pBirths[ixPerson], pDeaths[ixPerson]);
+        bins.flush();
+        return;
+    }
+
+    size_t             cntBins = (size_t)counter.width() + 1;
+    vector<binCount_t> lanes(cntBins * STORE_LANES, 0);
+    binCount_t        *pLane0  = lanes.data();
+    binCount_t        *pLane1  = pLane0 + cntBins;
+    binCount_t        *pLane2  = pLane1 + cntBins;
+    binCount_t        *pLane3  = pLane2 + cntBins;
+    size_t             cntChunk = min((size_t)STORE_CHUNK_PEOPLE, (size_t)numeric_limits<binCount_t>::max());
+    for (size_t ixChunk = 0; ixChunk < cnt; ixChunk += cntChunk)
+    {
+        size_t ixEnd    = min(cnt, ixChunk + cntChunk);
+        size_t ixPerson = ixChunk;
+        for (; ixPerson + STORE_LANES <= ixEnd; ixPerson += STORE_LANES)
+        {
+            ++pLane0[pBirths[ixPerson]];   ++pLane1[pBirths[ixPerson+1]];   ++pLane2[pBirths[ixPerson+2]];   ++pLane3[pBirths[ixPerson+3]];
+        }
+        for (; ixPerson < ixEnd; ixPerson++)
+            ++pLane0[pBirths[ixPerson]];
+        ixPerson = ixChunk;
+        for (; ixPerson + STORE_LANES <= ixEnd; ixPerson += STORE_LANES)
+        {
+            --pLane0[pDeaths[ixPerson]+1]; --pLane1[pDeaths[ixPerson+1]+1]; --pLane2[pDeaths[ixPerson+2]+1]; --pLane3[pDeaths[ixPerson+3]+1];
+        }
+        for (; ixPerson < ixEnd; ixPerson++)
+            --pLane0[pDeaths[ixPerson]+1];
+
+        for (size_t ixBin = 0; ixBin < cntBins; ixBin++)
+        {
+            pLane0[ixBin] += pLane1[ixBin] + pLane2[ixBin] + pLane3[ixBin];
+            pLane1[ixBin]  = pLane2[ixBin] = pLane3[ixBin] = 0;
+        }
+        counter.addBins(pLane0);
+        memset(pLane0, 0, cntBins * sizeof(binCount_t));
+    }
+}
+
+//=========================================================================
+// Name:    class yearIndex
+// Desc:
+//          range index over the population of each year (a finished yearCounter's counts()): a segment tree of
+//          the most people alive in each span of years, with a pending add per span.
+//          * maxOf()    - the most people alive in years ixBeg..ixEnd, in O(log n)
+//          * findTies() - the years ixBeg..ixEnd with that many alive, in O(log n) per year found
+//          * at()       - the people alive in a year, in O(log n)
+//          * addRange() - add (or, negative, remove) people alive in years ixBeg..ixEnd, in O(log n):
+//                         a person is inserted with addRange(ixBirth, ixDeath, 1), deleted with -1
+//          Years are offsets from the counter's range().yrBeg.
+//=========================================================================
+class yearIndex
+{
+public:
+    yearIndex(const long long *pAlive, size_t cnt);
+    void      addRange(size_t ixBeg, size_t ixEnd, long long delta);
+    long long maxOf(size_t ixBeg, size_t ixEnd) const;
+    void      findTies(size_t ixBeg, size_t ixEnd, long long cntMax, list<long long> &ixTies) const;
+    long long at(size_t ix) const  { return maxOf(ix, ix); }
+    size_t    size() const         { return _cnt; }
+private:
+    void      build(size_t ixNode, size_t ixLo, size_t ixHi, const long long *pAlive);
+    void      add(size_t ixNode, size_t ixLo, size_t ixHi, size_t ixBeg, size_t ixEnd, long long delta);
+    long long maxIn(size_t ixNode, size_t ixLo, size_t ixHi, size_t ixBeg, size_t ixEnd) const;
+    void      ties(size_t ixNode, size_t ixLo, size_t ixHi, size_t ixBeg, size_t ixEnd, long long cntWanted, list<long long> &ixTies) const;
+private:
+    size_t            _cnt;     // years indexed
+    vector<long long> _maxes;   // most alive in each node's years, with its own (not its ancestors') pending adds
+    vector<long long> _adds;    // pending add to every year of each node
+};
+
+yearIndex::yearIndex(const long long *pAlive, size_t cnt) : _cnt(cnt), _maxes(4*max(cnt, (size_t)1), 0), _adds(4*max(cnt, (size_t)1), 0)
+{
+    if (_cnt)
+        build(1, 0, _cnt-1, pAlive);
+}
+
+//--------------------------------------------------------------------------
+// Name: build()
+// Desc:
+//        fill a node (and its children) with the population of its years
+// Params:
+//       ixNode - the node; its children are 2*ixNode and 2*ixNode+1
+//       ixLo   - its first year
+//       ixHi   - its last year
+//       pAlive - the population of each year
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearIndex::build(size_t ixNode, size_t ixLo, size_t ixHi, const long long *pAlive)
+{
+    if (ixLo == ixHi)
+    {
+        _maxes[ixNode] = pAlive[ixLo];
+        return;
+    }
+    size_t ixMid = (ixLo + ixHi) / 2;
+    build(2*ixNode,   ixLo,    ixMid, pAlive);
+    build(2*ixNode+1, ixMid+1, ixHi,  pAlive);
+    _maxes[ixNode] = max(_maxes[2*ixNode], _maxes[2*ixNode+1]);
+}
+
+//--------------------------------------------------------------------------
+// Name: addRange()
+// Desc:
+//        add people alive in some years (see add())
+// Params:
+//       ixBeg - first year (0 <= ixBeg <= ixEnd < size())
+//       ixEnd - last year
+//       delta - people to add to each year; negative to remove them
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearIndex::addRange(size_t ixBeg, size_t ixEnd, long long delta)
+{
+    add(1, 0, _cnt-1, ixBeg, ixEnd, delta);
+}
+
+//--------------------------------------------------------------------------
+// Name: add()
+// Desc:
+//        add people alive in years ixBeg..ixEnd to a node: a node wholly inside them keeps the add pending, for all of
+//        its years, rather than passing it down to its children
+// Params:
+//       ixNode, ixLo, ixHi - the node, and its years (see build())
+//       ixBeg, ixEnd, delta - see addRange()
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearIndex::add(size_t ixNode, size_t ixLo, size_t ixHi, size_t ixBeg, size_t ixEnd, long long delta)
+{
+    if (ixEnd < ixLo || ixBeg > ixHi)
+        return;
+    if (ixBeg <= ixLo && ixHi <= ixEnd)
+    {
+        _adds[ixNode]  += delta;
+        _maxes[ixNode] += delta;
+        return;
+    }
+    size_t ixMid = (ixLo + ixHi) / 2;
+    add(2*ixNode,   ixLo,    ixMid, ixBeg, ixEnd, delta);
+    add(2*ixNode+1, ixMid+1, ixHi,  ixBeg, ixEnd, delta);
+    _maxes[ixNode] = _adds[ixNode] + max(_maxes[2*ixNode], _maxes[2*ixNode+1]);
+}
+
+//--------------------------------------------------------------------------
+// Name: maxOf()
+// Desc:
+//        the most people alive in any of some years
+// Params:
+//       ixBeg - first year (0 <= ixBeg <= ixEnd < size())
+//       ixEnd - last year
+// Returns:
+//      the most people alive
+//--------------------------------------------------------------------------
+long long yearIndex::maxOf(size_t ixBeg, size_t ixEnd) const
+{
+    return maxIn(1, 0, _cnt-1, ixBeg, ixEnd);
+}
+
+//--------------------------------------------------------------------------
+// Name: maxIn()
+// Desc:
+//        the most people alive in the node's years that are in ixBeg..ixEnd (they must overlap), without the pending
+//        adds of the node's ancestors
+// Params:
+//       ixNode, ixLo, ixHi - the node, and its years (see build())
+//       ixBeg, ixEnd       - see maxOf()
+// Returns:
+//      the most people alive
+//--------------------------------------------------------------------------
+long long yearIndex::maxIn(size_t ixNode, size_t ixLo, size_t ixHi, size_t ixBeg, size_t ixEnd) const
+{
+    if (ixBeg <= ixLo && ixHi <= ixEnd)
+        return _maxes[ixNode];
+    size_t ixMid = (ixLo + ixHi) / 2;
+    if (ixEnd <= ixMid)
+        return _adds[ixNode] + maxIn(2*ixNode, ixLo, ixMid, ixBeg, ixEnd);
+    if (ixBeg > ixMid)
+        return _adds[ixNode] + maxIn(2*ixNode+1, ixMid+1, ixHi, ixBeg, ixEnd);
+    return _adds[ixNode] + max(maxIn(2*ixNode, ixLo, ixMid, ixBeg, ixEnd), maxIn(2*ixNode+1, ixMid+1, ixHi, ixBeg, ixEnd));
+}
+
+//--------------------------------------------------------------------------
+// Name: findTies()
+// Desc:
+//        find the years, in order, that have a number of people alive (see maxOf()).
+//        Only the nodes that can hold that many are visited.
+// Params:
+//       ixBeg  - first year (0 <= ixBeg <= ixEnd < size())
+//       ixEnd  - last year
+//       cntMax - people alive; 0 finds no years (as yearScan::findTies())
+//       ixTies - the years are appended to this
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearIndex::findTies(size_t ixBeg, size_t ixEnd, long long cntMax, list<long long> &ixTies) const
+{
+    if (cntMax != 0)
+        ties(1, 0, _cnt-1, ixBeg, ixEnd, cntMax, ixTies);
+}
+
+//--------------------------------------------------------------------------
+// Name: ties()
+// Desc:
+//        find the node's years, in ixBeg..ixEnd, that have cntWanted people alive (without the pending adds of the
+//        node's ancestors)
+// Params:
+//       ixNode, ixLo, ixHi        - the node, and its years (see build())
+//       ixBeg, ixEnd, ixTies      - see findTies()
+//       cntWanted                 - people alive, less the pending adds of the node's ancestors
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void yearIndex::ties(size_t ixNode, size_t ixLo, size_t ixHi, size_t ixBeg, size_t ixEnd, long long cntWanted, list<long long> &ixTies) const
+{
+    if (ixEnd < ixLo || ixBeg > ixHi || _maxes[ixNode] < cntWanted)
+        return;
+    if (ixLo == ixHi)
+    {
+        if (_maxes[ixNode] == cntWanted)
+            ixTies.push_back(ixLo);
+        return;
+    }
+    size_t ixMid = (ixLo + ixHi) / 2;
+    ties(2*ixNode,   ixLo,    ixMid, ixBeg, ixEnd, cntWanted - _adds[ixNode], ixTies);
+    ties(2*ixNode+1, ixMid+1, ixHi,  ixBeg, ixEnd, cntWanted - _adds[ixNode], ixTies);
+}
+
+//=========================================================================
+// Name:    struct _binaryHeader
+// Desc:
+//          header of the binary population format (see populationInfo::generateVitalStats()).
+//          It is followed by cntRecords fixed-width records, each holding the years of birth & death
+//          as offsets from yrBeg: 8 bits each when the range fits in a byte (sizeRecord 2),
+//          otherwise 16 bits each, little endian (sizeRecord 4).
+//          Layout (little endian):
+//              [ 0.. 8) magic       [ 8..12) version   [12..14) yrBeg   [14..16) yrEnd
+//              [16..18) sizeRecord  [18..24) reserved  [24..32) cntRecords
+//=========================================================================
+typedef struct _binaryHeader
+{
+public:
+    enum { eSize = 32, eVersion = 1 };
+    _binaryHeader(int yrBeg=RANGE_YEAR_BEG, int yrEnd=RANGE_YEAR_END, unsigned long long cntRecs=0)
+      : yrBeg(yrBeg), yrEnd(yrEnd), sizeRecord((yrEnd-yrBeg < 256) ? 2 : 4), cntRecords(cntRecs) {}
+
+    void write(unsigned char *pDst) const;
+    bool read(const unsigned char *pSrc, size_t cntSrc);
+    static bool isBinary(const char *pSrc, size_t cntSrc) { return cntSrc >= sizeof(_magic) && memcmp(pSrc, _magic, sizeof(_magic)) == 0; }
+public:
+    int                yrBeg;       // year that record offsets are relative to
+    int                yrEnd;       // last year in range
+    int                sizeRecord;  // bytes per record
+    unsigned long long cntRecords;  // number of records following the header
+private:
+    static const char  _magic[8];
+} binaryHeader_t;
+
+const char binaryHeader_t::_magic[8] = { 'S', 'G', 'I', 'P', 'O', 'P', '\0', '\x1a' };
+
+//--------------------------------------------------------------------------
+// Name: write()
+// Desc:
+//        serialize the header
+// Params:
+//       pDst - eSize bytes to write to
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void binaryHeader_t::write(unsigned char *pDst) const
+{
+    memset(pDst, 0, eSize);
+    memcpy(pDst, _magic, sizeof(_magic));
+    pDst[ 8] = (unsigned char)eVersion;
+    pDst[12] = (unsigned char)(yrBeg);       pDst[13] = (unsigned char)(yrBeg >> 8);
+    pDst[14] = (unsigned char)(yrEnd);       pDst[15] = (unsigned char)(yrEnd >> 8);
+    pDst[16] = (unsigned char)(sizeRecord);
+    for (int ixByte = 0; ixByte < 8; ixByte++)
+        pDst[24+ixByte] = (unsigned char)(cntRecords >> (8*ixByte));
+}
+
+//--------------------------------------------------------------------------
+// Name: read()
+// Desc:
+//        deserialize and sanity check the header
+// Params:
+//       pSrc   - bytes at the start of the file
+//       cntSrc - number of bytes at pSrc
+// Returns:
+//      false if success; true if the bytes are not a supported binary header
+//--------------------------------------------------------------------------
+bool binaryHeader_t::read(const unsigned char *pSrc, size_t cntSrc)
+{
+    if (cntSrc < eSize || !isBinary((const char *)pSrc, cntSrc))
+        return true;
+
+    unsigned version = pSrc[8] | (pSrc[9] << 8) | (pSrc[10] << 16) | ((unsigned)pSrc[11] << 24);
+    yrBeg      = (short)(pSrc[12] | (pSrc[13] << 8));
+    yrEnd      = (short)(pSrc[14] | (pSrc[15] << 8));
+    sizeRecord = pSrc[16] | (pSrc[17] << 8);
+    cntRecords = 0;
+    for (int ixByte = 7; ixByte >= 0; ixByte--)
+        cntRecords = (cntRecords << 8) | pSrc[24+ixByte];
+
+    return (version != eVersion) || (yrBeg > yrEnd) || (sizeRecord != ((yrEnd-yrBeg < 256) ? 2 : 4));
+}
+
+//=========================================================================
+// Name:    class prefixHash
+// Desc:
+//          streaming 64 bit hash of the records a checkpoint covers (see checkpoint_t). The bytes may be added
+//          in pieces of any size, and hash the same as when added at once, so the counting pass hashes each
+//          block as it goes. Four lanes of 8 byte words are mixed independently (the xxHash64 round), which
+//          keeps the hash well ahead of the counting. Its state is saved with a checkpoint, so hashing carries on
+//          over the records appended since, whether or not the covered ones are hashed again.
+//=========================================================================
+class prefixHash
+{
+public:
+    enum { eSizeState = 72 };
+    prefixHash();
+    void               add(const char *pBeg, const char *pEnd);
+    unsigned long long value() const;
+    void               getState(unsigned char *pDst) const;
+    void               setState(const unsigned char *pSrc);
+private:
+    enum { eSizeStripe = 32 };
+    static inline unsigned long long rotl(unsigned long long x, int k) { return (x << k) | (x >> (64 - k)); }
+    static inline unsigned long long round(unsigned long long acc, unsigned long long word) { return rotl(acc + word * 0xc2b2ae3d27d4eb4fULL, 31) * 0x9e3779b185ebca87ULL; }
+    static inline unsigned long long load(const char *p);
+    inline void                      mix(const char *pStripe);
+private:
+    unsigned long long _lanes[4];
+    unsigned long long _cntBytes;           // bytes added
+    char               _tail[eSizeStripe];  // bytes added since the last whole stripe
+};
+
+//--------------------------------------------------------------------------
+// Name: prefixHash()
+// Desc:
+//        the hash of no bytes
+// Params:
+//       none
+// Returns:
+//      n/a
+//--------------------------------------------------------------------------
+prefixHash::prefixHash() : _cntBytes(0)
+{
+    _lanes[0] = 0x9e3779b185ebca87ULL + 0xc2b2ae3d27d4eb4fULL;
+    _lanes[1] = 0xc2b2ae3d27d4eb4fULL;
+    _lanes[2] = 0;
+    _lanes[3] = 0 - 0x9e3779b185ebca87ULL;
+}
+
+//--------------------------------------------------------------------------
+// Name: load()
+// Desc:
+//        the little endian 8 byte word at p (a single load, on a little endian machine)
+// Params:
+//       p - the word, at any alignment
+// Returns:
+//      the word
+//--------------------------------------------------------------------------
+inline unsigned long long prefixHash::load(const char *p)
+{
+    const unsigned char *pByte = (const unsigned char *)p;
+    return  (unsigned long long)pByte[0]        | ((unsigned long long)pByte[1] <<  8) | ((unsigned long long)pByte[2] << 16) |
+           ((unsigned long long)pByte[3] << 24) | ((unsigned long long)pByte[4] << 32) | ((unsigned long long)pByte[5] << 40) |
+           ((unsigned long long)pByte[6] << 48) | ((unsigned long long)pByte[7] << 56);
+}
+
+//--------------------------------------------------------------------------
+// Name: mix()
+// Desc:
+//        mix the eSizeStripe bytes at pStripe into the lanes, a word each
+// Params:
+//       pStripe - the bytes
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+inline void prefixHash::mix(const char *pStripe)
+{
+    _lanes[0] = round(_lanes[0], load(pStripe));
+    _lanes[1] = round(_lanes[1], load(pStripe + 8));
+    _lanes[2] = round(_lanes[2], load(pStripe + 16));
+    _lanes[3] = round(_lanes[3], load(pStripe + 24));
+}
+
+//--------------------------------------------------------------------------
+// Name: add()
+// Desc:
+//        hash the next bytes; a stripe split over several add()s is completed in _tail
+// Params:
+//       pBeg - first byte
+//       pEnd - one past the last byte
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void prefixHash::add(const char *pBeg, const char *pEnd)
+{
+    size_t cntTail = (size_t)(_cntBytes % eSizeStripe);
+    _cntBytes += pEnd - pBeg;
+    if (cntTail)
+    {
+        size_t cntFill = min((size_t)(pEnd - pBeg), eSizeStripe - cntTail);
+        memcpy(_tail + cntTail, pBeg, cntFill);
+        pBeg += cntFill;
+        if (cntTail + cntFill < eSizeStripe)
+            return;
+        mix(_tail);
+    }
+    for (; pEnd - pBeg >= eSizeStripe; pBeg += eSizeStripe)
+        mix(pBeg);
+    memcpy(_tail, pBeg, pEnd - pBeg);
+}
+
+//--------------------------------------------------------------------------
+// Name: value()
+// Desc:
+//        the hash of the bytes added so far: the lanes, the byte count and the bytes in _tail, avalanched
+// Params:
+//       none
+// Returns:
+//      the hash
+//--------------------------------------------------------------------------
+unsigned long long prefixHash::value() const
+{
+    unsigned long long hash = rotl(_lanes[0], 1) + rotl(_lanes[1], 7) + rotl(_lanes[2], 12) + rotl(_lanes[3], 18);
+    hash = round(hash, _cntBytes);
+    for (size_t ix = 0; ix < (size_t)(_cntBytes % eSizeStripe); ix++)
+        hash = (hash ^ (unsigned char)_tail[ix]) * 0x100000001b3ULL;
+    hash ^= hash >> 33;
+    hash *= 0xc2b2ae3d27d4eb4fULL;
+    hash ^= hash >> 29;
+    hash *= 0x165667b19e3779f9ULL;
+    return hash ^ (hash >> 32);
+}
+
+//--------------------------------------------------------------------------
+// Name: getState()
+// Desc:
+//        write the state (the lanes, the byte count and the bytes since the last whole stripe) as eSizeState bytes,
+//        little endian
+// Params:
+//       pDst - where to write the state
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void prefixHash::getState(unsigned char *pDst) const
+{
+    for (int ixByte = 0; ixByte < 8; ixByte++)
+    {
+        for (int ixLane = 0; ixLane < 4; ixLane++)
+            pDst[ixLane*8 + ixByte] = (unsigned char)(_lanes[ixLane] >> (8*ixByte));
+        pDst[32 + ixByte] = (unsigned char)(_cntBytes >> (8*ixByte));
+    }
+    memcpy(pDst + 40, _tail, eSizeStripe);
+}
+
+//--------------------------------------------------------------------------
+// Name: setState()
+// Desc:
+//        restore the state getState() wrote
+// Params:
+//       pSrc - the state
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void prefixHash::setState(const unsigned char *pSrc)
+{
+    for (int ixLane = 0; ixLane < 4; ixLane++)
+        _lanes[ixLane] = load((const char *)pSrc + ixLane*8);
+    _cntBytes = load((const char *)pSrc + 32);
+    memcpy(_tail, pSrc + 40, eSizeStripe);
+}
+
+//=========================================================================
+// Name:    struct _checkpoint
+// Desc:
+//          sidecar of a population file (see --checkpoint), so an append-only file can be re-analyzed
+//          by counting only the records appended since the last run.
+//          It holds the raw yearCounter counts of the first offEnd bytes (cntRecords records), and what the covered
+//          bytes (past any binary header, whose record count changes as records are appended) were:
+//          * edges  - a prefixHash of their first and last eSizeEdge bytes, and the file's inode (see edgesOf()).
+//                     Resuming checks just these (--checkpoint-verify=edges), so it reads O(appended) bytes: a file
+//                     that has been replaced or truncated, or changed near either end of the covered bytes, is caught
+//          * hash   - the prefixHash of all of them. --checkpoint-verify=full hashes the covered bytes again, which
+//                     catches a change anywhere, for a read of the whole file (still much cheaper than counting it)
+//          Any mismatch invalidates the checkpoint, and the whole file is counted.
+//          Layout (little endian):
+//              [ 0.. 8) magic       [ 8..12) version   [12..13) countEngine_t  [14..16) yrBeg  [16..18) yrEnd
+//              [24..32) offEnd      [32..40) cntRecords  [40..48) edges  [48..56) fileId  [56..128) hash state
+//              [128.. ) yrEnd-yrBeg+2 counts, 8 bytes each
+//=========================================================================
+typedef struct _checkpoint
+{
+public:
+    enum { eSizeHead = 128, eVersion = 3, eSizeHashRead = 1024*1024, eSizeEdge = 64*1024 };
+    _checkpoint() : countEngine(0), yrBeg(0), yrEnd(0), offEnd(0), cntRecords(0), edges(0), fileId(0) {}
+
+    bool write(const string &strFile) const;
+    bool read(const string &strFile);
+    static bool hashOf(const string &strFile, unsigned long long offBeg, unsigned long long offEnd, prefixHash &hash);
+    static bool edgesOf(const string &strFile, unsigned long long offBeg, unsigned long long offEnd, unsigned long long &edges);
+    static unsigned long long fileIdOf(const string &strFile);
+public:
+    int                countEngine; // argsAndErrs::countEngine_t the counts were made with
+    int                yrBeg;       // first year counted
+    int                yrEnd;       // last year counted
+    unsigned long long offEnd;      // bytes of the population file covered (always whole records)
+    unsigned long long cntRecords;  // records in the covered bytes
+    unsigned long long edges;       // prefixHash of the first and last eSizeEdge covered bytes (see edgesOf())
+    unsigned long long fileId;      // inode of the population file; 0 - unknown (see fileIdOf())
+    prefixHash         hash;        // hash of all the covered bytes (see hashOf())
+    vector<long long>  bins;        // raw yearCounter counts of the covered records
+private:
+    static const char  _magic[8];
+} checkpoint_t;
+
+const char checkpoint_t::_magic[8] = { 'S', 'G', 'I', 'C', 'K', 'P', '\0', '\x1a' };
+
+//--------------------------------------------------------------------------
+// Name: write()
+// Desc:
+//        save the checkpoint; a new file is written and renamed over the old one, so a crash never leaves half of one
+// Params:
+//       strFile - checkpoint file name
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool checkpoint_t::write(const string &strFile) const
+{
+    vector<unsigned char> buf(eSizeHead + bins.size()*8, 0);
+    unsigned char *pDst = buf.data();
+    memcpy(pDst, _magic, sizeof(_magic));
+    pDst[ 8] = (unsigned char)eVersion;
+    pDst[12] = (unsigned char)countEngine;
+    pDst[14] = (unsigned char)(yrBeg);       pDst[15] = (unsigned char)(yrBeg >> 8);
+    pDst[16] = (unsigned char)(yrEnd);       pDst[17] = (unsigned char)(yrEnd >> 8);
+    for (int ixByte = 0; ixByte < 8; ixByte++)
+    {
+        pDst[24+ixByte] = (unsigned char)(offEnd      >> (8*ixByte));
+        pDst[32+ixByte] = (unsigned char)(cntRecords  >> (8*ixByte));
+        pDst[40+ixByte] = (unsigned char)(edges       >> (8*ixByte));
+        pDst[48+ixByte] = (unsigned char)(fileId      >> (8*ixByte));
+        for (size_t ixBin = 0; ixBin < bins.size(); ixBin++)
+            pDst[eSizeHead + ixBin*8 + ixByte] = (unsigned char)((unsigned long long)bins[ixBin] >> (8*ixByte));
+    }
+    hash.getState(pDst + 56);
+
+    string   strTmp = strFile + ".tmp";
+    ofstream outStream(strTmp.c_str(), ios::out | ios::binary | ios::trunc);
+    outStream.write((const char *)buf.data(), buf.size());
+    outStream.close();
+    if (outStream.fail())
+        return true;
+#ifdef _WIN32
+    remove(strFile.c_str()); // rename() does not replace an existing file
+#endif
+    return rename(strTmp.c_str(), strFile.c_str()) != 0;
+}
+
+//--------------------------------------------------------------------------
+// Name: read()
+// Desc:
+//        load and sanity check the checkpoint
+// Params:
+//       strFile - checkpoint file name
+// Returns:
+//      false if success; true if there is no checkpoint, or it is not a supported one
+//--------------------------------------------------------------------------
+bool checkpoint_t::read(const string &strFile)
+{
+    ifstream inpStream(strFile.c_str(), ios::in | ios::binary);
+    unsigned char head[eSizeHead];
+    if (!inpStream.read((char *)head, sizeof(head)) || memcmp(head, _magic, sizeof(_magic)) != 0)
+        return true;
+
+    unsigned version = head[8] | (head[9] << 8) | (head[10] << 16) | ((unsigned)head[11] << 24);
+    countEngine = head[12];
+    yrBeg       = (short)(head[14] | (head[15] << 8));
+    yrEnd       = (short)(head[16] | (head[17] << 8));
+    offEnd = cntRecords = edges = fileId = 0;
+    for (int ixByte = 7; ixByte >= 0; ixByte--)
+    {
+        offEnd      = (offEnd      << 8) | head[24+ixByte];
+        cntRecords  = (cntRecords  << 8) | head[32+ixByte];
+        edges       = (edges       << 8) | head[40+ixByte];
+        fileId      = (fileId      << 8) | head[48+ixByte];
+    }
+    hash.setState(head + 56);
+    if (version != eVersion || yrBeg > yrEnd)
+        return true;
+
+    vector<unsigned char> buf((yrEnd-yrBeg+2) * 8);
+    if (!inpStream.read((char *)buf.data(), buf.size()))
+        return true;
+    bins.assign(yrEnd-yrBeg+2, 0);
+    for (size_t ixBin = 0; ixBin < bins.size(); ixBin++)
+    {
+        unsigned long long cnt = 0;
+        for (int ixByte = 7; ixByte >= 0; ixByte--)
+            cnt = (cnt << 8) | buf[ixBin*8 + ixByte];
+        bins[ixBin] = (long long)cnt;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: hashOf()
+// Desc:
+//        add all the bytes of [offBeg, offEnd) of the file to hash, read eSizeHashRead bytes at a time
+// Params:
+//       strFile - population file name
+//       offBeg  - first byte to cover
+//       offEnd  - one past the last byte to cover
+//       hash    - the hash to add the bytes to
+// Returns:
+//      false if success; true if the file can not be read, or is shorter than offEnd
+//--------------------------------------------------------------------------
+bool checkpoint_t::hashOf(const string &strFile, unsigned long long offBeg, unsigned long long offEnd, prefixHash &hash)
+{
+    FILE *pFile = fopen(strFile.c_str(), "rb");
+    if (pFile == nullptr)
+        return true;
+
+    vector<char> buf(eSizeHashRead);
+    bool         fErr = fseek64(pFile, (long long)offBeg, SEEK_SET) != 0;
+    for (unsigned long long off = offBeg; off < offEnd && !fErr; off += buf.size())
+    {
+        size_t cntRead = (size_t)min(offEnd - off, (unsigned long long)buf.size());
+        fErr = fread(buf.data(), 1, cntRead, pFile) != cntRead;
+        hash.add(buf.data(), buf.data() + cntRead);
+    }
+    fclose(pFile);
+    return fErr;
+}
+
+//--------------------------------------------------------------------------
+// Name: edgesOf()
+// Desc:
+//        prefixHash of the first and the last eSizeEdge bytes of [offBeg, offEnd) of the file (all of it, when
+//        that is smaller), so checking a checkpoint reads the same few bytes whatever the size of the file
+// Params:
+//       strFile - population file name
+//       offBeg  - first byte to cover
+//       offEnd  - one past the last byte to cover
+//       edges   - the hash
+// Returns:
+//      false if success; true if the file can not be read, or is shorter than offEnd
+//--------------------------------------------------------------------------
+bool checkpoint_t::edgesOf(const string &strFile, unsigned long long offBeg, unsigned long long offEnd, unsigned long long &edges)
+{
+    prefixHash hash;
+    bool       fErr;
+    if (offEnd - offBeg <= 2*(unsigned long long)eSizeEdge)
+        fErr = hashOf(strFile, offBeg, offEnd, hash);
+    else
+        fErr = hashOf(strFile, offBeg, offBeg + eSizeEdge, hash) || hashOf(strFile, offEnd - eSizeEdge, offEnd, hash);
+    edges = hash.value();
+    return fErr;
+}
+
+//--------------------------------------------------------------------------
+// Name: fileIdOf()
+// Desc:
+//        the inode of the file, so a population file replaced by another (e.g. regenerated) is not resumed
+// Params:
+//       strFile - population file name
+// Returns:
+//      the inode; 0 if it is unknown (on Windows, or the file can not be found)
+//--------------------------------------------------------------------------
+unsigned long long checkpoint_t::fileIdOf(const string &strFile)
+{
+#ifndef _WIN32
+    struct stat st;
+    if (stat(strFile.c_str(), &st) == 0)
+        return (unsigned long long)st.st_ino;
+#else
+    (void)strFile;
+#endif
+    return 0;
+}
+
+//=========================================================================
+// Name:    class workPool
+// Desc:
+//          work-stealing thread pool (see populationInfo::countFiles()).
+//          Each thread has its own queue of tasks: it runs the newest task of its own queue first (the chunks it just
+//          split off stay hot in its cache) and, once that is empty, steals the oldest task of another thread's queue.
+//          * submit() - queue a task, as part of a taskGroup
+//          * wait()   - run the group's tasks until all of them are done; the waiting thread helps, rather than idling
+//          A thread that waits inside a task only runs tasks of the group it waits for, so waits never nest deeply.
+//=========================================================================
+class workPool
+{
+public:
+    struct taskGroup
+    {
+        taskGroup() : cntPending(0), cntQueued(0) {}
+        atomic<long long> cntPending;   // tasks submitted, but not yet done
+        long long         cntQueued;    // tasks submitted, but not yet taken (guarded by workPool::_mtxIdle)
+    };
+
+    workPool(int cntThreads);
+    ~workPool();
+    void   submit(const function<void()> &task, taskGroup &group);
+    void   wait(taskGroup &group);
+    size_t threadCount() const { return _queues.size(); }
+    size_t selfQueue();
+private:
+    struct task_t
+    {
+        function<void()>  run;
+        taskGroup        *pGroup;
+    };
+    struct queue_t
+    {
+        mutex             mtx;
+        deque<task_t>     tasks;
+    };
+    bool   takeTask(size_t ixSelf, const taskGroup *pOnly, task_t &task);
+    void   runTask(task_t &task);
+private:
+    vector<unique_ptr<queue_t>> _queues;      // one per pool thread, and a last one shared by all other threads
+    vector<thread>              _threads;     // pool threads
+    mutex                       _mtxIdle;     // guards the waits on _cvIdle
+    condition_variable          _cvIdle;      // a task was queued, or a group is done
+    long long                   _cntQueued;   // tasks in all queues (guarded by _mtxIdle)
+    bool                        _fStop;       // the pool threads are to exit
+    static thread_local size_t  _ixQueue;     // this thread's queue; 0 - not a pool thread
+    static thread_local int     _cntDepth;    // tasks this thread is running (a task waiting on a group runs its tasks)
+};
+
+thread_local size_t workPool::_ixQueue  = 0;
+thread_local int    workPool::_cntDepth = 0;
+
+//--------------------------------------------------------------------------
+// Name: workPool()
+// Desc:
+//        start the pool threads; the thread calling wait() helps, so cntThreads-1 are started
+// Params:
+//       cntThreads - threads running tasks at the same time
+//--------------------------------------------------------------------------
+workPool::workPool(int cntThreads) : _cntQueued(0), _fStop(false)
+{
+    size_t cntPool = (size_t)max(1, cntThreads) - 1;
+    for (size_t ixQueue = 0; ixQueue <= cntPool; ixQueue++)
+        _queues.push_back(unique_ptr<queue_t>(new queue_t));
+    for (size_t ixThread = 0; ixThread < cntPool; ixThread++)
+    {
+        _threads.push_back(thread([this, ixThread]()
+        {
+            _ixQueue = ixThread + 1;
+            task_t task;
+            for (;;)
+            {
+                if (takeTask(ixThread, nullptr, task))
+                {
+                    runTask(task);
+                    continue;
+                }
+                unique_lock<mutex> lock(_mtxIdle);
+                _cvIdle.wait(lock, [&]() { return _fStop || _cntQueued > 0; });
+                if (_fStop)
+                    break;
+            }
+        }));
+    }
+}
+
+workPool::~workPool()
+{
+    {
+        lock_guard<mutex> lock(_mtxIdle);
+        _fStop = true;
+    }
+    _cvIdle.notify_all();
+    for (auto &worker : _threads)
+        worker.join();
+}
+
+//--------------------------------------------------------------------------
+// Name: selfQueue()
+// Desc:
+//        the calling thread's queue. Each thread running the pool's tasks has its own, so it also indexes
+//        per-thread state of a task group (see populationInfo::countBlock()); only one thread outside the pool may wait()
+// Returns:
+//      index into _queues, below threadCount()
+//--------------------------------------------------------------------------
+size_t workPool::selfQueue()
+{
+    return _ixQueue ? _ixQueue - 1 : _queues.size() - 1;
+}
+
+//--------------------------------------------------------------------------
+// Name: submit()
+// Desc:
+//        queue a task on the calling thread's queue
+// Params:
+//       task  - the work
+//       group - what wait() will wait for
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void workPool::submit(const function<void()> &task, taskGroup &group)
+{
+    task_t t;
+    t.run    = task;
+    t.pGroup = &group;
+    group.cntPending++;
+
+    queue_t &queue = *_queues[selfQueue()];
+    {
+        lock_guard<mutex> lock(queue.mtx);
+        queue.tasks.push_back(t);
+    }
+    {
+        lock_guard<mutex> lock(_mtxIdle);
+        _cntQueued++;
+        group.cntQueued++;
+    }
+    _cvIdle.notify_all();
+}
+
+//--------------------------------------------------------------------------
+// Name: takeTask()
+// Desc:
+//        take the newest task of the thread's own queue, else steal the oldest task of another queue
+// Params:
+//       ixSelf - the thread's queue
+//       pOnly  - only take tasks of this group; nullptr for any task
+//       task   - the task taken
+// Returns:
+//      true if a task was taken
+//--------------------------------------------------------------------------
+bool workPool::takeTask(size_t ixSelf, const taskGroup *pOnly, task_t &task)
+{
+    for (size_t ixTry = 0; ixTry < _queues.size(); ixTry++)
+    {
+        size_t   ixQueue = (ixSelf + ixTry) % _queues.size();
+        queue_t &queue   = *_queues[ixQueue];
+        lock_guard<mutex> lock(queue.mtx);
+        if (queue.tasks.empty())
+            continue;
+
+        deque<task_t>::iterator it = queue.tasks.end();
+        if (pOnly == nullptr)
+            it = (ixTry == 0) ? queue.tasks.end() - 1 : queue.tasks.begin();
+        else if (ixTry == 0)
+        {
+            for (auto itBack = queue.tasks.rbegin(); itBack != queue.tasks.rend() && it == queue.tasks.end(); ++itBack)
+                if (itBack->pGroup == pOnly)
+                    it = itBack.base() - 1;
+        }
+        else
+        {
+            for (auto itFront = queue.tasks.begin(); itFront != queue.tasks.end() && it == queue.tasks.end(); ++itFront)
+                if (itFront->pGroup == pOnly)
+                    it = itFront;
+        }
+        if (it == queue.tasks.end())
+            continue;
+
+        task = *it;
+        queue.tasks.erase(it);
+        lock_guard<mutex> lockIdle(_mtxIdle);
+        _cntQueued--;
+        task.pGroup->cntQueued--;
+        return true;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: runTask()
+// Desc:
+//        run a task, then count it off its group (waking the group's waiters, once it is done)
+// Params:
+//       task - the task to run
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void workPool::runTask(task_t &task)
+{
+    _cntDepth++;
+    task.run();
+    _cntDepth--;
+    if (--task.pGroup->cntPending == 0)
+    {
+        lock_guard<mutex> lock(_mtxIdle);
+        _cvIdle.notify_all();
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: wait()
+// Desc:
+//        run tasks, on this thread too, until all of the group's tasks are done.
+//        Outside of a task, any queued task is run meanwhile; inside one, only the group's
+// Params:
+//       group - tasks to wait for
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void workPool::wait(taskGroup &group)
+{
+    size_t           ixSelf = selfQueue();
+    const taskGroup *pOnly  = _cntDepth ? &group : nullptr; // inside a task: only the group's tasks, so waits never nest
+    task_t           task;
+    while (group.cntPending > 0)
+    {
+        if (takeTask(ixSelf, pOnly, task))
+        {
+            runTask(task);
+            continue;
+        }
+        // The group's last tasks are running on other threads; sleep until they are done (or more can be taken)
+        unique_lock<mutex> lock(_mtxIdle);
+        _cvIdle.wait(lock, [&]() { return group.cntPending == 0 || (pOnly ? group.cntQueued : _cntQueued) > 0; });
+    }
+}
+
+//=========================================================================
+// Name:    class populationReader
+// Desc:
+//          interface for reading a population file as blocks of whole records,
+//          so the records can be parsed in place (see populationInfo::countBlock())
+//          * peek()       - the first bytes of the file, e.g. to detect its format
+//          * setFraming() - bytes to skip (a header) and the size of each record (0 - newline terminated)
+//          * nextBlock()  - the next block of whole records
+//          * offset()     - file offset one past the last block handed out
+//          * failed()     - whether nextBlock() stopped early, on data it could not read (see whyFailed())
+//=========================================================================
+class populationReader
+{
+public:
+    populationReader() : _cntSkip(0), _sizeRecord(0), _offBlkEnd(0) {}
+    virtual ~populationReader() {}
+    virtual bool   open(const string &strFile) = 0;                         // false if success; true if error
+    virtual size_t peek(char *pDst, size_t cnt) = 0;                        // number of bytes copied
+    virtual bool   nextBlock(const char *&pBlk, const char *&pBlkEnd) = 0;  // false once there are no more blocks
+    virtual void   setFraming(size_t cntSkip, size_t sizeRecord) { _cntSkip = cntSkip; _sizeRecord = sizeRecord; }
+    virtual unsigned long long offset() { return _offBlkEnd; }
+    virtual bool   resumable() { return true; }   // offset() is an offset into the file itself (see --checkpoint)
+    virtual bool   failed()    { return false; }  // the file could not all be read (e.g. corrupt compressed data)
+    virtual const char *whyFailed() { return "Reading it failed (an I/O error)."; }
+protected:
+    size_t wholeRecords(const char *pBuf, size_t cntScanned, size_t cntBuf) const;
+protected:
+    size_t _cntSkip;        // bytes at the start of the file that are not records (a header, or records already counted)
+    size_t _sizeRecord;     // bytes per fixed-width record; 0 for newline terminated records
+    unsigned long long _offBlkEnd; // file offset one past the last block handed out
+};
+
+//=========================================================================
+// Name:    class bufferedReader
+// Desc:
+//          reads a population file with large unbuffered reads.
+//          Each block ends at a record boundary; a partial record is carried over into the next block.
+//=========================================================================
+class bufferedReader : public populationReader
+{
+public:
+    bufferedReader(size_t sizeRead = 4*1024*1024) : _pFile(nullptr), _sizeRead(sizeRead), _cntCarry(0), _fEof(false), _fFailed(false), _offRead(0) {}
+    ~bufferedReader() { if (_pFile && _pFile != stdin) fclose(_pFile); }
+    bool   open(const string &strFile);
+    size_t peek(char *pDst, size_t cnt);
+    bool   nextBlock(const char *&pBlk, const char *&pBlkEnd);
+    bool   failed() { return _fFailed; }
+private:
+    FILE        *_pFile;        // population file
+    size_t       _sizeRead;     // bytes to read per block
+    vector<char> _buf;          // carried over partial record, followed by the bytes just read
+    size_t       _cntCarry;     // bytes at the end of _buf that belong to the next block
+    bool         _fEof;         // end of file has been reached
+    bool         _fFailed;      // a read failed (ferror()), rather than reaching the end of the file
+    unsigned long long _offRead; // bytes of the file read (or skipped over)
+};
+
+//--------------------------------------------------------------------------
+// Name: open()
+// Desc:
+//        open the population file for read
+// Params:
+//       strFile - population file name
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool bufferedReader::open(const string &strFile)
+{
+    if (strFile == STDIN_FILE_NAME)
+    {
+        // Read straight from the pipe; nothing here seeks
+#ifdef _WIN32
+        _setmode(_fileno(stdin), _O_BINARY);
+#endif
+        _pFile = stdin;
+    }
+    else
+        _pFile = fopen(strFile.c_str(), "rb");
+    if (_pFile == nullptr)
+        return true;
+    setvbuf(_pFile, nullptr, _IONBF, 0); // reads are already large, skip stdio's copy
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: peek()
+// Desc:
+//        copy the first bytes of the file; they are still handed out by nextBlock()
+// Params:
+//       pDst - where to copy to
+//       cnt  - number of bytes wanted
+// Returns:
+//      number of bytes copied (less than cnt if the file is shorter)
+//--------------------------------------------------------------------------
+size_t bufferedReader::peek(char *pDst, size_t cnt)
+{
+    if (_buf.empty() && !_fEof)
+    {
+        _buf.resize(cnt);
+        size_t cntRead = fread(_buf.data(), 1, cnt, _pFile);
+        if (cntRead < cnt)
+        {
+            _fEof    = true;
+            _fFailed = ferror(_pFile) != 0;
+        }
+        _offRead += cntRead;
+        _buf.resize(cntRead);
+        _cntCarry = cntRead;
+    }
+    size_t cntCopy = min(cnt, _buf.size());
+    memcpy(pDst, _buf.data(), cntCopy);
+    return cntCopy;
+}
+
+//--------------------------------------------------------------------------
+// Name: wholeRecords()
+// Desc:
+//        find the end of the last whole record in the buffer
+// Params:
+//       pBuf       - the buffer
+//       cntScanned - bytes at the front of the buffer already known not to end a newline terminated record
+//       cntBuf     - bytes in the buffer
+// Returns:
+//      number of bytes of whole records at the front of the buffer (0 if none)
+//--------------------------------------------------------------------------
+size_t populationReader::wholeRecords(const char *pBuf, size_t cntScanned, size_t cntBuf) const
+{
+    if (_sizeRecord)
+        return cntBuf - cntBuf % _sizeRecord;
+
+    for (const char *p = pBuf + cntBuf; p > pBuf + cntScanned; )
+    {
+        if (*--p == '\n')
+            return (p+1) - pBuf;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------
+// Name: nextBlock()
+// Desc:
+//        read the next block of whole records
+// Params:
+//       pBlk    - first char of the block
+//       pBlkEnd - one past the last char of the block
+// Returns:
+//      false once there are no more blocks
+//--------------------------------------------------------------------------
+bool bufferedReader::nextBlock(const char *&pBlk, const char *&pBlkEnd)
+{
+    // Move the partial record left over from the last block to the front
+    size_t cntPrev = _buf.size();
+    if (_cntCarry)
+        memmove(_buf.data(), _buf.data() + cntPrev - _cntCarry, _cntCarry);
+    size_t cntBuf = _cntCarry;
+    _cntCarry = 0;
+
+    size_t cntScanned = 0;
+    for (;;)
+    {
+        if (_cntSkip && cntBuf)
+        {
+            // Drop the header
+            size_t cntDrop = min(_cntSkip, cntBuf);
+            memmove(_buf.data(), _buf.data() + cntDrop, cntBuf - cntDrop);
+            cntBuf   -= cntDrop;
+            _cntSkip -= cntDrop;
+        }
+
+        size_t cntWhole = (_cntSkip == 0) ? wholeRecords(_buf.data(), cntScanned, cntBuf) : 0;
+        if (cntWhole && (_fEof || cntBuf >= _sizeRead))
+        {
+            _cntCarry = cntBuf - cntWhole;
+            cntBuf    = cntWhole;
+            break;
+        }
+        if (_fEof)
+            break; // whatever is left is the last (unterminated) record
+        cntScanned = cntBuf;
+
+        if (_cntSkip && cntBuf == 0 && fseek64(_pFile, (long long)_cntSkip, SEEK_CUR) == 0)
+        {
+            // Seek past the rest of the skipped bytes (a pipe can't; they are read and dropped)
+            _offRead += _cntSkip;
+            _cntSkip  = 0;
+        }
+
+        // A record longer than a block just grows the buffer
+        _buf.resize(cntBuf + _sizeRead);
+        size_t cntRead = fread(_buf.data() + cntBuf, 1, _sizeRead, _pFile);
+        if (cntRead < _sizeRead)
+        {
+            _fEof    = true;
+            _fFailed = ferror(_pFile) != 0;
+        }
+        _offRead += cntRead;
+        cntBuf   += cntRead;
+    }
+    _buf.resize(cntBuf + _cntCarry);
+    _offBlkEnd = _offRead - _cntCarry;
+
+    pBlk    = _buf.data();
+    pBlkEnd = _buf.data() + cntBuf;
+    return cntBuf != 0;
+}
+
+//=========================================================================
+// Name:    class asyncReader
+// Desc:
+//          reads a population file ahead of the parser: a reader thread keeps ASYNC_BUFFERS large reads in flight,
+//          so the parse of one block overlaps the reads of the next ones (e.g. on network attached storage or a pipe).
+//          Each buffer has ASYNC_CARRY_BYTES free in front of its bytes, where the partial record left over from
+//          the block before is copied, so a block is handed out from the buffer it was read into.
+//=========================================================================
+class asyncReader : public populationReader
+{
+public:
+    asyncReader(size_t sizeRead = 4*1024*1024);
+    ~asyncReader();
+    bool   open(const string &strFile);
+    size_t peek(char *pDst, size_t cnt);
+    bool   nextBlock(const char *&pBlk, const char *&pBlkEnd);
+    bool   failed();
+private:
+    #define ASYNC_BUFFERS     (3)         // buffers read into, or handed out, at once
+    #define ASYNC_CARRY_BYTES (64*1024)   // room in front of each buffer for the partial record before it
+
+    struct buffer_t
+    {
+        vector<char> bytes;     // ASYNC_CARRY_BYTES of room, then the bytes read
+        size_t       cntRead;   // bytes read
+    };
+    void start();
+    void readAhead();
+    bool takeBuffer(char *&pData, size_t &cntData);
+    void releaseBuffer();
+private:
+    FILE              *_pFile;        // population file
+    size_t             _sizeRead;     // bytes to read per buffer
+    vector<buffer_t>   _bufs;         // ring of buffers, filled in turn by the reader thread
+    thread             _reader;       // the reader thread (started by the first nextBlock())
+    mutex              _mtx;          // guards the counts and flags below
+    condition_variable _cv;           // a buffer was filled, or released
+    size_t             _cntFilled;    // buffers read, but not yet taken
+    size_t             _cntInUse;     // buffers read, but not yet released (taken ones are released by the next block)
+    bool               _fEof;         // the reader thread has read the last buffer
+    bool               _fFailed;      // a read failed (ferror()), rather than reaching the end of the file
+    bool               _fStop;        // the reader thread is to exit
+    bool               _fStarted;     // the reader thread was started
+    bool               _fHeld;        // a taken buffer holds the block last handed out
+    size_t             _ixTake;       // next buffer to take
+    vector<char>       _peek;         // bytes read by peek(), before the reader thread started
+    vector<char>       _carry;        // partial record left over from the last block
+    vector<char>       _joined;       // a block whose partial record did not fit in front of its buffer
+    unsigned long long _offRead;      // bytes of the file taken (or skipped over)
+};
+
+asyncReader::asyncReader(size_t sizeRead) : _pFile(nullptr), _sizeRead(sizeRead), _bufs(ASYNC_BUFFERS), _cntFilled(0), _cntInUse(0),
+                                            _fEof(false), _fFailed(false), _fStop(false), _fStarted(false), _fHeld(false), _ixTake(0), _offRead(0)
+{
+}
+
+asyncReader::~asyncReader()
+{
+    if (_fStarted)
+    {
+        {
+            lock_guard<mutex> lock(_mtx);
+            _fStop = true;
+        }
+        _cv.notify_all();
+        _reader.join(); // waits for a read in flight
+    }
+    if (_pFile && _pFile != stdin)
+        fclose(_pFile);
+}
+
+//--------------------------------------------------------------------------
+// Name: open()
+// Desc:
+//        open the population file for read
+// Params:
+//       strFile - population file name
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool asyncReader::open(const string &strFile)
+{
+    if (strFile == STDIN_FILE_NAME)
+    {
+#ifdef _WIN32
+        _setmode(_fileno(stdin), _O_BINARY);
+#endif
+        _pFile = stdin;
+    }
+    else
+        _pFile = fopen(strFile.c_str(), "rb");
+    if (_pFile == nullptr)
+        return true;
+    setvbuf(_pFile, nullptr, _IONBF, 0); // reads are already large, skip stdio's copy
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: peek()
+// Desc:
+//        copy the first bytes of the file; they are still handed out by nextBlock()
+// Params:
+//       pDst - where to copy to
+//       cnt  - number of bytes wanted
+// Returns:
+//      number of bytes copied (less than cnt if the file is shorter)
+//--------------------------------------------------------------------------
+size_t asyncReader::peek(char *pDst, size_t cnt)
+{
+    if (!_fStarted && _peek.size() < cnt)
+    {
+        size_t cntHave = _peek.size();
+        _peek.resize(cnt);
+        _peek.resize(cntHave + fread(_peek.data() + cntHave, 1, cnt - cntHave, _pFile));
+        _fFailed = ferror(_pFile) != 0;
+    }
+    size_t cntCopy = min(cnt, _peek.size());
+    memcpy(pDst, _peek.data(), cntCopy);
+    return cntCopy;
+}
+
+//--------------------------------------------------------------------------
+// Name: start()
+// Desc:
+//        skip the bytes that are not records (seeking, where the file can), then start the reader thread.
+//        The peeked bytes that are records become the first partial record
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void asyncReader::start()
+{
+    size_t cntDrop = min(_cntSkip, _peek.size());
+    _carry.assign(_peek.begin() + cntDrop, _peek.end());
+    _offRead  = _peek.size();
+    _cntSkip -= cntDrop;
+    _peek.clear();
+    if (_cntSkip && fseek64(_pFile, (long long)_cntSkip, SEEK_CUR) == 0)
+    {
+        _offRead += _cntSkip;
+        _cntSkip  = 0;
+    }
+
+    for (auto &buf : _bufs)
+        buf.bytes.resize(ASYNC_CARRY_BYTES + _sizeRead);
+    _fStarted = true;
+    _reader   = thread([this]() { readAhead(); });
+}
+
+//--------------------------------------------------------------------------
+// Name: readAhead()
+// Desc:
+//        the reader thread: fill each free buffer in turn, until the end of the file (or a read error)
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void asyncReader::readAhead()
+{
+    for (size_t ixFill = 0; ; ixFill = (ixFill + 1) % ASYNC_BUFFERS)
+    {
+        {
+            unique_lock<mutex> lock(_mtx);
+            _cv.wait(lock, [&]() { return _fStop || _cntInUse < ASYNC_BUFFERS; });
+            if (_fStop)
+                break;
+        }
+        // The buffer is free: the parser has released it, and won't take it until it is counted as filled
+        buffer_t &buf = _bufs[ixFill];
+        buf.cntRead   = _fFailed ? 0 : fread(buf.bytes.data() + ASYNC_CARRY_BYTES, 1, _sizeRead, _pFile);
+        bool fEof     = buf.cntRead < _sizeRead;
+        {
+            lock_guard<mutex> lock(_mtx);
+            _cntFilled++;
+            _cntInUse++;
+            _fEof     = fEof;
+            _fFailed |= fEof && ferror(_pFile) != 0;
+        }
+        _cv.notify_all();
+        if (fEof)
+            break;
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: failed()
+// Desc:
+//        whether the reader thread (or peek()) stopped on a read error, rather than the end of the file
+// Params:
+//       <none>
+// Returns:
+//      true if a read failed
+//--------------------------------------------------------------------------
+bool asyncReader::failed()
+{
+    lock_guard<mutex> lock(_mtx);
+    return _fFailed;
+}
+
+//--------------------------------------------------------------------------
+// Name: takeBuffer()
+// Desc:
+//        wait for the next buffer to be read
+// Params:
+//       pData   - the bytes read
+//       cntData - number of bytes read
+// Returns:
+//      false once the whole file has been taken
+//--------------------------------------------------------------------------
+bool asyncReader::takeBuffer(char *&pData, size_t &cntData)
+{
+    {
+        unique_lock<mutex> lock(_mtx);
+        _cv.wait(lock, [&]() { return _cntFilled > 0 || _fEof; });
+        if (_cntFilled == 0)
+            return false;
+        _cntFilled--;
+    }
+    buffer_t &buf = _bufs[_ixTake];
+    pData   = buf.bytes.data() + ASYNC_CARRY_BYTES;
+    cntData = buf.cntRead;
+    _fHeld  = true;
+    return true;
+}
+
+//--------------------------------------------------------------------------
+// Name: releaseBuffer()
+// Desc:
+//        hand the buffer taken last back to the reader thread
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void asyncReader::releaseBuffer()
+{
+    if (!_fHeld)
+        return;
+    _fHeld  = false;
+    _ixTake = (_ixTake + 1) % ASYNC_BUFFERS;
+    {
+        lock_guard<mutex> lock(_mtx);
+        _cntInUse--;
+    }
+    _cv.notify_all();
+}
+
+//--------------------------------------------------------------------------
+// Name: nextBlock()
+// Desc:
+//        the next block of whole records: the partial record left over from the last block, then the whole
+//        records of the next buffer read. A record longer than a buffer is joined from several of them
+// Params:
+//       pBlk    - first char of the block
+//       pBlkEnd - one past the last char of the block
+// Returns:
+//      false once there are no more blocks
+//--------------------------------------------------------------------------
+bool asyncReader::nextBlock(const char *&pBlk, const char *&pBlkEnd)
+{
+    if (!_fStarted)
+        start();
+    releaseBuffer(); // the last block has been counted
+
+    char  *pData;
+    size_t cntData;
+    size_t cntUsed;  // bytes of the buffer in the block
+    for (;;)
+    {
+        if (!takeBuffer(pData, cntData))
+        {
+            // Whatever is left is the last (unterminated) record
+            _joined.swap(_carry);
+            _carry.clear();
+            _offBlkEnd = _offRead;
+            pBlk       = _joined.data();
+            pBlkEnd    = _joined.data() + _joined.size();
+            return pBlk != pBlkEnd;
+        }
+        _offRead += cntData;
+        if (_cntSkip)
+        {
+            // Drop the rest of a header that could not be seeked past (a pipe)
+            size_t cntDrop = min(_cntSkip, cntData);
+            pData    += cntDrop;
+            cntData  -= cntDrop;
+            _cntSkip -= cntDrop;
+        }
+
+        // The whole records: up to the last newline, or a multiple of the record size
+        bool fWhole = false;
+        if (_sizeRecord)
+        {
+            size_t cntAll  = _carry.size() + cntData;
+            size_t cntRecs = cntAll - cntAll % _sizeRecord;
+            fWhole  = cntRecs > 0 && cntRecs >= _carry.size();
+            cntUsed = fWhole ? cntRecs - _carry.size() : 0;
+        }
+        else
+        {
+            const char *pNl = pData + cntData;
+            while (pNl > pData && pNl[-1] != '\n')
+                pNl--;
+            fWhole  = pNl > pData;
+            cntUsed = pNl - pData;
+        }
+        if (fWhole)
+            break;
+        // No record ends in this buffer; it all belongs to the next block
+        _carry.insert(_carry.end(), pData, pData + cntData);
+        releaseBuffer();
+    }
+
+    // The partial record goes in front of the bytes read (or, if it is too long, the block is joined in _joined)
+    if (_carry.size() <= ASYNC_CARRY_BYTES)
+    {
+        memcpy(pData - _carry.size(), _carry.data(), _carry.size());
+        pBlk    = pData - _carry.size();
+        pBlkEnd = pData + cntUsed;
+    }
+    else
+    {
+        _joined.swap(_carry);
+        _joined.insert(_joined.end(), pData, pData + cntUsed);
+        pBlk    = _joined.data();
+        pBlkEnd = _joined.data() + _joined.size();
+    }
+    _carry.assign(pData + cntUsed, pData + cntData);
+    _offBlkEnd = _offRead - _carry.size();
+    return true;
+}
+
+//=========================================================================
+// Name:    class mmapReader
+// Desc:
+//          maps the whole population file into memory and hands it out as a single block.
+//          Falls back to asyncReader where the file can not be mapped (Windows, pipes, ...)
+//=========================================================================
+class mmapReader : public populationReader
+{
+public:
+    mmapReader(size_t sizeRead = 4*1024*1024) : _pMap(nullptr), _sizeMap(0), _fBlockDone(false), _fallback(sizeRead) {}
+    ~mmapReader();
+    bool   open(const string &strFile);
+    size_t peek(char *pDst, size_t cnt);
+    bool   nextBlock(const char *&pBlk, const char *&pBlkEnd);
+    void   setFraming(size_t cntSkip, size_t sizeRecord) { populationReader::setFraming(cntSkip, sizeRecord); _fallback.setFraming(cntSkip, sizeRecord); }
+    unsigned long long offset() { return _pMap ? _offBlkEnd : _fallback.offset(); }
+    bool   failed() { return _pMap ? false : _fallback.failed(); }
+private:
+    const char      *_pMap;         // mapped file
+    size_t           _sizeMap;      // bytes mapped
+    bool             _fBlockDone;   // the mapped block has been handed out
+    asyncReader      _fallback;     // used when _pMap is nullptr
+};
+
+//--------------------------------------------------------------------------
+// Name: open()
+// Desc:
+//        map the population file into memory (or open the fallback reader)
+// Params:
+//       strFile - population file name
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool mmapReader::open(const string &strFile)
+{
+#ifndef _WIN32
+    if (strFile == STDIN_FILE_NAME)
+        return _fallback.open(strFile);
+    int fd = ::open(strFile.c_str(), O_RDONLY);
+    if (fd < 0)
+        return true;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void *pMap = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMap != MAP_FAILED)
+        {
+            madvise(pMap, (size_t)st.st_size, MADV_SEQUENTIAL);
+            _pMap    = (const char *)pMap;
+            _sizeMap = (size_t)st.st_size;
+        }
+    }
+    close(fd); // the mapping stays valid
+    if (_pMap)
+        return false;
+#endif
+    return _fallback.open(strFile);
+}
+
+//--------------------------------------------------------------------------
+// Name: peek()
+// Desc:
+//        copy the first bytes of the file; they are still handed out by nextBlock()
+// Params:
+//       pDst - where to copy to
+//       cnt  - number of bytes wanted
+// Returns:
+//      number of bytes copied (less than cnt if the file is shorter)
+//--------------------------------------------------------------------------
+size_t mmapReader::peek(char *pDst, size_t cnt)
+{
+    if (_pMap == nullptr)
+        return _fallback.peek(pDst, cnt);
+    size_t cntCopy = min(cnt, _sizeMap);
+    memcpy(pDst, _pMap, cntCopy);
+    return cntCopy;
+}
+
+//--------------------------------------------------------------------------
+// Name: nextBlock()
+// Desc:
+//        hand out the mapped file (or the fallback reader's next block)
+// Params:
+//       pBlk    - first char of the block
+//       pBlkEnd - one past the last char of the block
+// Returns:
+//      false once there are no more blocks
+//--------------------------------------------------------------------------
+bool mmapReader::nextBlock(const char *&pBlk, const char *&pBlkEnd)
+{
+    if (_pMap == nullptr)
+        return _fallback.nextBlock(pBlk, pBlkEnd);
+    if (_fBlockDone)
+        return false;
+    _fBlockDone = true;
+    pBlk       = _pMap + min(_cntSkip, _sizeMap);
+    pBlkEnd    = _pMap + _sizeMap;
+    _offBlkEnd = _sizeMap;
+    return pBlk != pBlkEnd;
+}
+
+mmapReader::~mmapReader()
+{
+#ifndef _WIN32
+    if (_pMap)
+        munmap((void *)_pMap, _sizeMap);
+#endif
+}
+
+//=========================================================================
+// Name:    class frameCodec
+// Desc:
+//          compressed population files (see --compress), written as a series of independently compressed frames,
+//          each of whole records: gzip members that record their own size in an 'SG' extra field (as BGZF does), or
+//          zstd frames that record their content size. Every frame, and its size, is found without decompressing
+//          any, so the frames can be decompressed in parallel (see compressedReader).
+//          Other gzip or zstd files (e.g. from gzip or zstd themselves) can only be decompressed as one stream.
+//          * detect()          - the codec of a file, by its magic
+//          * supported()       - whether this build has the codec (SGI_WITH_ZLIB, SGI_WITH_ZSTD)
+//          * compressFrame()   - compress a frame
+//          * indexFrames()     - find every frame of a file, and its sizes
+//          * decompressFrame() - decompress a frame, into a buffer of its size
+//=========================================================================
+class frameCodec
+{
+public:
+    struct frame_t
+    {
+        size_t offIn;     // offset of the frame in the file
+        size_t sizeIn;    // compressed bytes
+        size_t sizeOut;   // decompressed bytes
+    };
+    static argsAndErrs::compress_t detect(const char *p, size_t cnt);
+    static bool        supported(argsAndErrs::compress_t codec);
+    static const char *name(argsAndErrs::compress_t codec) { return (codec == argsAndErrs::eCompress_Gzip) ? "gzip" : "zstd"; }
+    static bool        compressFrame(argsAndErrs::compress_t codec, const char *pSrc, size_t cntSrc, vector<char> &frames);
+    static bool        indexFrames(argsAndErrs::compress_t codec, const unsigned char *pIn, size_t sizeIn, vector<frame_t> &frames);
+    static bool        decompressFrame(argsAndErrs::compress_t codec, const unsigned char *pIn, const frame_t &frame, char *pOut);
+private:
+    static uint32_t    get32(const unsigned char *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+    static void        put32(unsigned char *p, uint32_t val) { for (int ix = 0; ix < 4; ix++) p[ix] = (unsigned char)(val >> (8*ix)); }
+private:
+    enum { eGzipHeader = 20, eGzipTrailer = 8 };  // gzip member header (with the 'SG' extra field), and its crc32 + size
+    enum { eLevel = 1 };                          // compression level: fast; the records compress well anyway
+    #define MAX_FRAME_BYTES (256*1024*1024)       // largest frame decompressed all at once
+};
+
+//--------------------------------------------------------------------------
+// Name: detect()
+// Desc:
+//        the codec of a file, by its first bytes
+// Params:
+//       p   - first bytes of the file
+//       cnt - number of bytes
+// Returns:
+//      eCompress_None if the file is not compressed
+//--------------------------------------------------------------------------
+argsAndErrs::compress_t frameCodec::detect(const char *p, size_t cnt)
+{
+    const unsigned char *pu = (const unsigned char *)p;
+    if (cnt >= 2 && pu[0] == 0x1f && pu[1] == 0x8b)
+        return argsAndErrs::eCompress_Gzip;
+    if (cnt >= 4 && get32(pu) == 0xfd2fb528)
+        return argsAndErrs::eCompress_Zstd;
+    return argsAndErrs::eCompress_None;
+}
+
+//--------------------------------------------------------------------------
+// Name: supported()
+// Desc:
+//        whether this build can compress and decompress the codec
+// Params:
+//       codec - the codec
+// Returns:
+//      true if supported
+//--------------------------------------------------------------------------
+bool frameCodec::supported(argsAndErrs::compress_t codec)
+{
+    return (codec == argsAndErrs::eCompress_None) || (codec == argsAndErrs::eCompress_Gzip && SGI_WITH_ZLIB) ||
+           (codec == argsAndErrs::eCompress_Zstd && SGI_WITH_ZSTD);
+}
+
+//--------------------------------------------------------------------------
+// Name: compressFrame()
+// Desc:
+//        compress bytes (whole records) as a frame, appended to frames
+// Params:
+//       codec  - the codec
+//       pSrc   - the bytes to compress
+//       cntSrc - number of bytes
+//       frames - the frame is appended to this
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool frameCodec::compressFrame(argsAndErrs::compress_t codec, const char *pSrc, size_t cntSrc, vector<char> &frames)
+{
+    size_t offFrame = frames.size();
+    (void)pSrc; (void)cntSrc; (void)offFrame;
+#if SGI_WITH_ZLIB
+    if (codec == argsAndErrs::eCompress_Gzip)
+    {
+        if (cntSrc > numeric_limits<uInt>::max())
+            return true;
+        z_stream z;
+        memset(&z, 0, sizeof(z));
+        if (deflateInit2(&z, eLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            return true;
+        frames.resize(offFrame + eGzipHeader + deflateBound(&z, (uLong)cntSrc) + eGzipTrailer);
+        unsigned char *pFrame = (unsigned char *)&frames[offFrame];
+        z.next_in   = (Bytef *)pSrc;
+        z.avail_in  = (uInt)cntSrc;
+        z.next_out  = pFrame + eGzipHeader;
+        z.avail_out = (uInt)(frames.size() - offFrame - eGzipHeader - eGzipTrailer);
+        int ret = deflate(&z, Z_FINISH);
+        size_t cntBody = z.total_out;
+        deflateEnd(&z);
+        if (ret != Z_STREAM_END)
+            return true;
+
+        // ID1 ID2 CM FLG(FEXTRA) MTIME XFL OS XLEN, then the 'SG' subfield: LEN, the member's size
+        static const unsigned char header[eGzipHeader] = { 0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 255, 8, 0, 'S', 'G', 4, 0, 0, 0, 0, 0 };
+        size_t sizeFrame = eGzipHeader + cntBody + eGzipTrailer;
+        memcpy(pFrame, header, eGzipHeader);
+        put32(pFrame + 16, (uint32_t)sizeFrame);
+        put32(pFrame + eGzipHeader + cntBody,     (uint32_t)crc32(0, (const Bytef *)pSrc, (uInt)cntSrc));
+        put32(pFrame + eGzipHeader + cntBody + 4, (uint32_t)cntSrc);
+        frames.resize(offFrame + sizeFrame);
+        return false;
+    }
+#endif
+#if SGI_WITH_ZSTD
+    if (codec == argsAndErrs::eCompress_Zstd)
+    {
+        // ZSTD_compress() records the content size in the frame header
+        frames.resize(offFrame + ZSTD_compressBound(cntSrc));
+        size_t sizeFrame = ZSTD_compress(&frames[offFrame], frames.size() - offFrame, pSrc, cntSrc, eLevel);
+        if (ZSTD_isError(sizeFrame))
+            return true;
+        frames.resize(offFrame + sizeFrame);
+        return false;
+    }
+#endif
+    (void)codec;
+    return true;
+}
+
+//--------------------------------------------------------------------------
+// Name: indexFrames()
+// Desc:
+//        find every frame of a compressed file, and its compressed and decompressed sizes, without decompressing any
+// Params:
+//       codec  - the codec
+//       pIn    - the compressed file
+//       sizeIn - its size
+//       frames - every frame, in file order
+// Returns:
+//      false if success; true if a frame (or its size) can not be found, or a frame is over MAX_FRAME_BYTES:
+//      the file is decompressed as one stream
+//--------------------------------------------------------------------------
+bool frameCodec::indexFrames(argsAndErrs::compress_t codec, const unsigned char *pIn, size_t sizeIn, vector<frame_t> &frames)
+{
+    frames.clear();
+    for (size_t offIn = 0; offIn < sizeIn; )
+    {
+        const unsigned char *p       = pIn + offIn;
+        size_t               cntLeft = sizeIn - offIn;
+        frame_t              frame;
+        frame.offIn = offIn;
+        if (codec == argsAndErrs::eCompress_Gzip)
+        {
+            // Only the members written by compressFrame() record their size
+            if (cntLeft < eGzipHeader + eGzipTrailer || p[0] != 0x1f || p[1] != 0x8b || p[2] != 8 || p[3] != 4 ||
+                p[10] != 8 || p[11] != 0 || p[12] != 'S' || p[13] != 'G' || p[14] != 4 || p[15] != 0)
+                return true;
+            frame.sizeIn = get32(p + 16);
+            if (frame.sizeIn < eGzipHeader + eGzipTrailer || frame.sizeIn > cntLeft)
+                return true;
+            frame.sizeOut = get32(p + frame.sizeIn - 4);
+        }
+        else
+        {
+#if SGI_WITH_ZSTD
+            frame.sizeIn = ZSTD_findFrameCompressedSize(p, cntLeft);
+            unsigned long long sizeOut = ZSTD_getFrameContentSize(p, cntLeft);
+            if (ZSTD_isError(frame.sizeIn) || sizeOut == ZSTD_CONTENTSIZE_UNKNOWN || sizeOut == ZSTD_CONTENTSIZE_ERROR)
+                return true;
+            frame.sizeOut = (size_t)sizeOut;
+#else
+            (void)p;
+            return true;
+#endif
+        }
+        if (frame.sizeOut > MAX_FRAME_BYTES)
+            return true;
+        frames.push_back(frame);
+        offIn += frame.sizeIn;
+    }
+    return frames.empty();
+}
+
+//--------------------------------------------------------------------------
+// Name: decompressFrame()
+// Desc:
+//        decompress a frame found by indexFrames()
+// Params:
+//       codec - the codec
+//       pIn   - the compressed file
+//       frame - the frame
+//       pOut  - where to decompress to; frame.sizeOut bytes
+// Returns:
+//      false if success; true if the frame is corrupt
+//--------------------------------------------------------------------------
+bool frameCodec::decompressFrame(argsAndErrs::compress_t codec, const unsigned char *pIn, const frame_t &frame, char *pOut)
+{
+    (void)pIn; (void)frame; (void)pOut;
+#if SGI_WITH_ZLIB
+    if (codec == argsAndErrs::eCompress_Gzip)
+    {
+        char     chEmpty;
+        z_stream z;
+        memset(&z, 0, sizeof(z));
+        if (inflateInit2(&z, 16 + MAX_WBITS) != Z_OK)
+            return true;
+        z.next_in   = (Bytef *)(pIn + frame.offIn);
+        z.avail_in  = (uInt)frame.sizeIn;
+        z.next_out  = (Bytef *)(frame.sizeOut ? pOut : &chEmpty);
+        z.avail_out = (uInt)frame.sizeOut;
+        int ret = inflate(&z, Z_FINISH);
+        bool fBad = (ret != Z_STREAM_END) || (z.total_out != frame.sizeOut);
+        inflateEnd(&z);
+        return fBad;
+    }
+#endif
+#if SGI_WITH_ZSTD
+    if (codec == argsAndErrs::eCompress_Zstd)
+        return ZSTD_decompress(pOut, frame.sizeOut, pIn + frame.offIn, frame.sizeIn) != frame.sizeOut;
+#endif
+    (void)codec;
+    return true;
+}
+
+//=========================================================================
+// Name:    class compressedReader
+// Desc:
+//          reads a compressed population file (see frameCodec), as blocks of whole records.
+//          The file's frames are decompressed in parallel straight into the block that is then counted (in parallel
+//          too, see populationInfo::countBlock()): a task per frame on the workPool that counts the block, or, without
+//          one, on up to cntThreads threads. A file whose frames can not be found up front is decompressed as one stream.
+//          offset() is in decompressed bytes, so a compressed file can not be resumed from a checkpoint.
+//=========================================================================
+class compressedReader : public populationReader
+{
+public:
+    compressedReader(argsAndErrs::compress_t codec, workPool *pPool, int cntThreads, size_t sizeRead = 4*1024*1024);
+    ~compressedReader();
+    bool   open(const string &strFile);
+    size_t peek(char *pDst, size_t cnt);
+    bool   nextBlock(const char *&pBlk, const char *&pBlkEnd);
+    bool   resumable() { return false; }
+    bool   failed()    { return _fFailed; }
+    const char *whyFailed() { return "Its compressed data is corrupt, or truncated."; }
+private:
+    void   decompressMore(size_t cntBuf);
+    size_t decompressFrames(size_t cntBuf);
+    size_t decompressStream(size_t cntBuf);
+private:
+    argsAndErrs::compress_t        _codec;       // how the file is compressed
+    workPool                      *_pPool;       // pool to decompress the frames on; nullptr to start threads for each block
+    int                            _cntThreads;  // threads decompressing frames at once, without a pool
+    size_t                         _sizeRead;    // decompressed bytes per block (at least a frame)
+    const unsigned char           *_pIn;         // the compressed file (mapped, or in _bytesIn)
+    size_t                         _sizeIn;      // its size
+    bool                           _fMapped;     // _pIn is mapped
+    vector<unsigned char>          _bytesIn;     // the compressed file, where it can not be mapped
+    vector<frameCodec::frame_t>    _frames;      // every frame; empty if the file is decompressed as one stream
+    size_t                         _ixFrame;     // next frame to decompress
+    size_t                         _offIn;       // bytes of the stream decompressed so far (without _frames)
+    bool                           _fStarted;    // the stream decompressor is set up
+    vector<char>                   _buf;         // carried over partial record, followed by the bytes just decompressed
+    size_t                         _cntCarry;    // bytes at the end of _buf that belong to the next block
+    bool                           _fEof;        // everything has been decompressed
+    bool                           _fFailed;     // the compressed data is corrupt (or truncated)
+    unsigned long long             _offOut;      // bytes decompressed (or skipped over)
+#if SGI_WITH_ZLIB
+    z_stream                       _z;           // stream decompressor (gzip)
+#endif
+#if SGI_WITH_ZSTD
+    ZSTD_DStream                  *_pZstd;       // stream decompressor (zstd)
+#endif
+};
+
+compressedReader::compressedReader(argsAndErrs::compress_t codec, workPool *pPool, int cntThreads, size_t sizeRead) : _codec(codec), _pPool(pPool),
+                    _cntThreads(max(1, cntThreads)),
+                    _sizeRead(sizeRead), _pIn(nullptr), _sizeIn(0), _fMapped(false), _ixFrame(0), _offIn(0), _fStarted(false),
+                    _cntCarry(0), _fEof(false), _fFailed(false), _offOut(0)
+{
+#if SGI_WITH_ZSTD
+    _pZstd = nullptr;
+#endif
+}
+
+compressedReader::~compressedReader()
+{
+#if SGI_WITH_ZLIB
+    if (_fStarted && _codec == argsAndErrs::eCompress_Gzip)
+        inflateEnd(&_z);
+#endif
+#if SGI_WITH_ZSTD
+    if (_pZstd)
+        ZSTD_freeDStream(_pZstd);
+#endif
+#ifndef _WIN32
+    if (_fMapped)
+        munmap((void *)_pIn, _sizeIn);
+#endif
+}
+
+//--------------------------------------------------------------------------
+// Name: open()
+// Desc:
+//        map the compressed file into memory (or read all of it, where it can not be mapped), and find its frames
+// Params:
+//       strFile - population file name
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool compressedReader::open(const string &strFile)
+{
+#ifndef _WIN32
+    int fd = ::open(strFile.c_str(), O_RDONLY);
+    if (fd < 0)
+        return true;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void *pMap = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMap != MAP_FAILED)
+        {
+            madvise(pMap, (size_t)st.st_size, MADV_WILLNEED); // the frames are read in parallel, not in order
+            _pIn     = (const unsigned char *)pMap;
+            _sizeIn  = (size_t)st.st_size;
+            _fMapped = true;
+        }
+    }
+    close(fd);
+#endif
+    if (!_fMapped)
+    {
+        FILE *pFile = fopen(strFile.c_str(), "rb");
+        if (pFile == nullptr)
+            return true;
+        unsigned char chunk[64*1024];
+        size_t        cntRead;
+        while ((cntRead = fread(chunk, 1, sizeof(chunk), pFile)) > 0)
+            _bytesIn.insert(_bytesIn.end(), chunk, chunk + cntRead);
+        bool fErr = ferror(pFile) != 0;
+        fclose(pFile);
+        if (fErr)
+            return true;
+        _pIn    = _bytesIn.data();
+        _sizeIn = _bytesIn.size();
+    }
+    if (frameCodec::indexFrames(_codec, _pIn, _sizeIn, _frames))
+        _frames.clear();
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: peek()
+// Desc:
+//        copy the first decompressed bytes; they are still handed out by nextBlock()
+// Params:
+//       pDst - where to copy to
+//       cnt  - number of bytes wanted
+// Returns:
+//      number of bytes copied (less than cnt if the file is shorter)
+//--------------------------------------------------------------------------
+size_t compressedReader::peek(char *pDst, size_t cnt)
+{
+    while (_buf.size() < cnt && !_fEof)
+        decompressMore(_buf.size());
+    _cntCarry = _buf.size();
+    size_t cntCopy = min(cnt, _buf.size());
+    memcpy(pDst, _buf.data(), cntCopy);
+    return cntCopy;
+}
+
+//--------------------------------------------------------------------------
+// Name: decompressMore()
+// Desc:
+//        decompress the next bytes onto the end of the buffer, which is resized to what was decompressed.
+//        Sets _fEof once everything has been (or a corrupt frame stops it), and _fFailed if the data is corrupt
+// Params:
+//       cntBuf - bytes in the buffer, to keep
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void compressedReader::decompressMore(size_t cntBuf)
+{
+    size_t cntOut = _frames.size() ? decompressFrames(cntBuf) : decompressStream(cntBuf);
+    _buf.resize(cntBuf + cntOut);
+    _offOut += cntOut;
+    if (_fFailed)
+        _fEof = true;
+}
+
+//--------------------------------------------------------------------------
+// Name: decompressFrames()
+// Desc:
+//        decompress the next frames, at least one and about _sizeRead bytes of them, in parallel: each frame is
+//        decompressed straight into its place in the buffer, by a task of the pool (or by the next of the threads
+//        started for the block to take it)
+// Params:
+//       cntBuf - bytes in the buffer, to keep
+// Returns:
+//      bytes decompressed
+//--------------------------------------------------------------------------
+size_t compressedReader::decompressFrames(size_t cntBuf)
+{
+    size_t         ixFirst = _ixFrame;
+    vector<size_t> offs;   // where each frame goes in the buffer
+    size_t         cntOut  = 0;
+    while (_ixFrame < _frames.size() && (cntOut == 0 || cntOut + _frames[_ixFrame].sizeOut <= _sizeRead))
+    {
+        offs.push_back(cntBuf + cntOut);
+        cntOut += _frames[_ixFrame++].sizeOut;
+    }
+    _fEof = (_ixFrame == _frames.size());
+    _buf.resize(cntBuf + cntOut);
+
+    atomic<bool> fBad(false);
+    if (_pPool && offs.size() > 1)
+    {
+        // The waiting thread helps; the pool's other threads are not left idle while the block is decompressed
+        workPool::taskGroup group;
+        for (size_t ix = 0; ix < offs.size(); ix++)
+            _pPool->submit([&, ix]()
+            {
+                if (frameCodec::decompressFrame(_codec, _pIn, _frames[ixFirst + ix], _buf.data() + offs[ix]))
+                    fBad = true;
+            }, group);
+        _pPool->wait(group);
+    }
+    else
+    {
+        atomic<size_t> ixNext(0);
+        auto decompressAll = [&]()
+        {
+            for (size_t ix; (ix = ixNext++) < offs.size(); )
+                if (frameCodec::decompressFrame(_codec, _pIn, _frames[ixFirst + ix], _buf.data() + offs[ix]))
+                    fBad = true;
+        };
+        vector<thread> workers;
+        for (size_t ixWorker = 1; ixWorker < min((size_t)_cntThreads, offs.size()); ixWorker++)
+            workers.push_back(thread(decompressAll));
+        decompressAll();
+        for (auto &worker : workers)
+            worker.join();
+    }
+    if (fBad)
+    {
+        _fFailed = true;
+        return 0;
+    }
+    return cntOut;
+}
+
+//--------------------------------------------------------------------------
+// Name: decompressStream()
+// Desc:
+//        decompress the next _sizeRead bytes of a file whose frames could not be found (on this thread);
+//        concatenated gzip members (or zstd frames) are decompressed one after the other
+// Params:
+//       cntBuf - bytes in the buffer, to keep
+// Returns:
+//      bytes decompressed
+//--------------------------------------------------------------------------
+size_t compressedReader::decompressStream(size_t cntBuf)
+{
+    _buf.resize(cntBuf + _sizeRead);
+    size_t cntOut = 0;
+#if SGI_WITH_ZLIB
+    if (_codec == argsAndErrs::eCompress_Gzip)
+    {
+        if (!_fStarted)
+        {
+            memset(&_z, 0, sizeof(_z));
+            if (inflateInit2(&_z, 16 + MAX_WBITS) != Z_OK)
+            {
+                _fFailed = true;
+                return 0;
+            }
+            _fStarted = true;
+        }
+        while (cntOut < _sizeRead && !_fEof)
+        {
+            _z.next_in   = (Bytef *)(_pIn + _offIn);
+            _z.avail_in  = (uInt)min(_sizeIn - _offIn, (size_t)numeric_limits<uInt>::max());
+            _z.next_out  = (Bytef *)(_buf.data() + cntBuf + cntOut);
+            _z.avail_out = (uInt)(_sizeRead - cntOut);
+            uInt cntIn   = _z.avail_in;
+            uInt cntRoom = _z.avail_out;
+            int  ret     = inflate(&_z, Z_NO_FLUSH);
+            _offIn += cntIn - _z.avail_in;
+            cntOut += cntRoom - _z.avail_out;
+            if (ret == Z_STREAM_END)
+            {
+                // On to the next gzip member, if there is one
+                _fEof = (_offIn == _sizeIn);
+                if (!_fEof)
+                    inflateReset(&_z);
+                continue;
+            }
+            // No progress, with room to spare: the input ends inside a member
+            if ((ret != Z_OK && ret != Z_BUF_ERROR) || (cntIn == _z.avail_in && cntRoom == _z.avail_out))
+            {
+                _fFailed = true;
+                break;
+            }
+        }
+        return cntOut;
+    }
+#endif
+#if SGI_WITH_ZSTD
+    if (_codec == argsAndErrs::eCompress_Zstd)
+    {
+        if (_pZstd == nullptr && ((_pZstd = ZSTD_createDStream()) == nullptr || ZSTD_isError(ZSTD_initDStream(_pZstd))))
+        {
+            _fFailed = true;
+            return 0;
+        }
+        ZSTD_inBuffer  in  = { _pIn, _sizeIn, _offIn };
+        ZSTD_outBuffer out = { _buf.data() + cntBuf, _sizeRead, 0 };
+        while (out.pos < out.size)
+        {
+            size_t posIn  = in.pos;
+            size_t posOut = out.pos;
+            size_t ret    = ZSTD_decompressStream(_pZstd, &out, &in);
+            if (!ZSTD_isError(ret) && ret == 0 && in.pos == in.size)
+            {
+                _fEof = true; // the last frame is done, and all of it is out
+                break;
+            }
+            // No progress, with room to spare: the input ends inside a frame
+            if (ZSTD_isError(ret) || (in.pos == posIn && out.pos == posOut))
+            {
+                _fFailed = true;
+                break;
+            }
+        }
+        _offIn = in.pos;
+        cntOut = out.pos;
+        return cntOut;
+    }
+#endif
+    _fFailed = true;
+    return cntOut;
+}
+
+//--------------------------------------------------------------------------
+// Name: nextBlock()
+// Desc:
+//        decompress the next block of whole records
+// Params:
+//       pBlk    - first char of the block
+//       pBlkEnd - one past the last char of the block
+// Returns:
+//      false once there are no more blocks (or the compressed data is corrupt, see failed())
+//--------------------------------------------------------------------------
+bool compressedReader::nextBlock(const char *&pBlk, const char *&pBlkEnd)
+{
+    // Move the partial record left over from the last block to the front
+    size_t cntPrev = _buf.size();
+    if (_cntCarry)
+        memmove(_buf.data(), _buf.data() + cntPrev - _cntCarry, _cntCarry);
+    size_t cntBuf = _cntCarry;
+    _cntCarry = 0;
+    _buf.resize(cntBuf);
+
+    size_t cntScanned = 0;
+    for (;;)
+    {
+        if (_cntSkip && cntBuf)
+        {
+            // Drop the header
+            size_t cntDrop = min(_cntSkip, cntBuf);
+            memmove(_buf.data(), _buf.data() + cntDrop, cntBuf - cntDrop);
+            cntBuf   -= cntDrop;
+            _cntSkip -= cntDrop;
+            _buf.resize(cntBuf);
+        }
+
+        size_t cntWhole = (_cntSkip == 0) ? wholeRecords(_buf.data(), cntScanned, cntBuf) : 0;
+        if (cntWhole && (_fEof || cntBuf >= _sizeRead))
+        {
+            _cntCarry = cntBuf - cntWhole;
+            cntBuf    = cntWhole;
+            break;
+        }
+        if (_fEof)
+            break; // whatever is left is the last (unterminated) record
+        cntScanned = cntBuf;
+        decompressMore(cntBuf);
+        cntBuf = _buf.size();
+    }
+    if (_fFailed)
+        return false;
+    _offBlkEnd = _offOut - _cntCarry;
+
+    pBlk    = _buf.data();
+    pBlkEnd = _buf.data() + cntBuf;
+    return cntBuf != 0;
+}
+
+//=========================================================================
+// Name:    class xoshiro256
+// Desc:
+//          xoshiro256** pseudo random number generator (Blackman & Vigna), seeded through splitmix64.
+//          jump() advances it by 2^128 numbers, giving each generating thread its own independent stream.
+//=========================================================================
+class xoshiro256
+{
+public:
+    xoshiro256(unsigned long long seed);
+    inline unsigned long long next();
+    inline int                below(int n) { return (int)(((next() >> 32) * (unsigned long long)n) >> 32); } // 0 to n-1
+    void                      jump();
+private:
+    static inline unsigned long long rotl(unsigned long long x, int k) { return (x << k) | (x >> (64 - k)); }
+private:
+    unsigned long long _s[4];   // generator state
+};
+
+//--------------------------------------------------------------------------
+// Name: xoshiro256()
+// Desc:
+//        seed the state with splitmix64, so similar seeds still give unrelated streams
+// Params:
+//       seed - any value
+//--------------------------------------------------------------------------
+xoshiro256::xoshiro256(unsigned long long seed)
+{
+    for (int ix = 0; ix < 4; ix++)
+    {
+        unsigned long long z = (seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        _s[ix] = z ^ (z >> 31);
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: next()
+// Desc:
+//        next 64 bit pseudo random number
+// Params:
+//       <none>
+// Returns:
+//      the number
+//--------------------------------------------------------------------------
+inline unsigned long long xoshiro256::next()
+{
+    unsigned long long result = rotl(_s[1] * 5, 7) * 9;
+    unsigned long long t      = _s[1] << 17;
+    _s[2] ^= _s[0];
+    _s[3] ^= _s[1];
+    _s[1] ^= _s[2];
+    _s[0] ^= _s[3];
+    _s[2] ^= t;
+    _s[3]  = rotl(_s[3], 45);
+    return result;
+}
+
+//--------------------------------------------------------------------------
+// Name: jump()
+// Desc:
+//        advance the generator by 2^128 calls to next()
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void xoshiro256::jump()
+{
+    static const unsigned long long JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+
+    unsigned long long s[4] = { 0, 0, 0, 0 };
+    for (int ixJump = 0; ixJump < 4; ixJump++)
+    {
+        for (int ixBit = 0; ixBit < 64; ixBit++)
+        {
+            if (JUMP[ixJump] & (1ULL << ixBit))
+            {
+                for (int ix = 0; ix < 4; ix++)
+                    s[ix] ^= _s[ix];
+            }
+            next();
+        }
+    }
+    for (int ix = 0; ix < 4; ix++)
+        _s[ix] = s[ix];
+}
+
+//=========================================================================
+// Name:    class outputBuffer
+// Desc:
+//          large, reusable buffer that records are formatted into.
+//          It is written to the stream in big blocks (no per-record write or flush).
+//          With a codec (see --compress), each block is compressed as a frame of its own (see frameCodec).
+//=========================================================================
+class outputBuffer
+{
+public:
+    outputBuffer(ostream &outStream, size_t sizeFlush = 4*1024*1024, argsAndErrs::compress_t codec = argsAndErrs::eCompress_None)
+        : _outStream(outStream), _buf((sizeFlush ? sizeFlush : 4*1024*1024) + 256), _cntBuf(0), _sizeFlush(sizeFlush), _codec(codec) {}
+    ~outputBuffer() { flush(); }
+
+    void put(char ch)                      { reserve(1); _buf[_cntBuf++] = ch; }
+    void put(const char *p, size_t cnt)    { reserve(cnt); memcpy(&_buf[_cntBuf], p, cnt); _cntBuf += cnt; }
+    void put(const string &str)            { put(str.data(), str.size()); }
+    void putInt(long long val);
+    void endRecord()                       { if (_sizeFlush && _cntBuf >= _sizeFlush) flush(); }
+    void compressFrame();
+    void flush();
+private:
+    void reserve(size_t cnt)               { if (_cntBuf + cnt > _buf.size()) _buf.resize(2*(_cntBuf + cnt)); }
+private:
+    ostream      &_outStream;   // where the buffer is written to
+    vector<char>  _buf;         // formatted records
+    size_t        _cntBuf;      // bytes in _buf
+    size_t        _sizeFlush;   // bytes at which endRecord() writes the buffer out; 0 - only flush() writes it
+    argsAndErrs::compress_t _codec; // how each block is compressed
+    vector<char>  _frames;      // blocks compressed, but not yet written
+};
+
+//--------------------------------------------------------------------------
+// Name: putInt()
+// Desc:
+//        format an integer, in decimal, into the buffer
+// Params:
+//       val - integer to format
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void outputBuffer::putInt(long long val)
+{
+    char digits[24];
+    char *p = digits + sizeof(digits);
+    unsigned long long mag = (val < 0) ? 0ULL - (unsigned long long)val : (unsigned long long)val;
+    do
+    {
+        *--p = (char)('0' + mag % 10);
+        mag /= 10;
+    } while (mag);
+    if (val < 0)
+        *--p = '-';
+    put(p, digits + sizeof(digits) - p);
+}
+
+//--------------------------------------------------------------------------
+// Name: flush()
+// Desc:
+//        write the buffered records to the stream
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void outputBuffer::flush()
+{
+    if (_codec != argsAndErrs::eCompress_None)
+    {
+        compressFrame();
+        if (_frames.size())
+            _outStream.write(_frames.data(), _frames.size());
+        _frames.clear();
+        return;
+    }
+    if (_cntBuf)
+        _outStream.write(_buf.data(), _cntBuf);
+    _cntBuf = 0;
+}
+
+//--------------------------------------------------------------------------
+// Name: compressFrame()
+// Desc:
+//        compress the buffered records as a frame, to be written by flush(); so a worker can compress its records
+//        before it waits for its turn to write them (see populationInfo::generateStreams())
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void outputBuffer::compressFrame()
+{
+    if (_codec == argsAndErrs::eCompress_None || _cntBuf == 0)
+        return;
+    if (frameCodec::compressFrame(_codec, _buf.data(), _cntBuf, _frames))
+        _outStream.setstate(ios::failbit);
+    _cntBuf = 0;
+}
+
+//=========================================================================
+// Name:    class runStats
+// Desc:
+//          where the time of a run goes, and what it read (see --stats).
+//          * phaseTimer - adds the wall time of a scope (or of each phase, in turn) to a phase; does nothing without a runStats
+//          * report()   - writes the phases and counters, as text or JSON
+//          The counters are added per block and per file, never per record, so the parse/count loops are untouched.
+//          Phase times of files counted at once (on a workPool) are summed, so they can add up to more than the run.
+//          Without SGI_STATS, phaseTimer is empty. Allocations are only counted with SGI_COUNT_ALLOCS, which
+//          replaces the global operator new/delete (with malloc/free), so it is off unless asked for.
+//=========================================================================
+#ifndef SGI_STATS
+#define SGI_STATS 1
+#endif
+#ifndef SGI_COUNT_ALLOCS
+#define SGI_COUNT_ALLOCS 0
+#endif
+class runStats
+{
+public:
+    enum phase_t { ePhase_Generate, ePhase_Open, ePhase_Read, ePhase_Count, ePhase_Reduce, ePhase_Report, ePhase_Cnt };
+    class phaseTimer
+    {
+    public:
+#if SGI_STATS
+        phaseTimer(runStats *pStats, phase_t phase) : _pStats(pStats), _phase(phase) { if (_pStats) _tmBeg = chrono::steady_clock::now(); }
+        ~phaseTimer()                { stop(); }
+        void next(phase_t phase)     { stop(); _phase = phase; if (_pStats) _tmBeg = chrono::steady_clock::now(); }
+        void stop()                  { if (_pStats && _phase != ePhase_Cnt) _pStats->add(_phase, chrono::steady_clock::now() - _tmBeg); _phase = ePhase_Cnt; }
+    private:
+        runStats                 *_pStats;  // where the time goes; nullptr - not timed
+        phase_t                   _phase;   // phase being timed; ePhase_Cnt - none
+        chrono::steady_clock::time_point _tmBeg; // when the phase began
+#else
+        phaseTimer(runStats *, phase_t) {}
+        void next(phase_t)           {}
+        void stop()                  {}
+#endif
+    };
+
+    runStats();
+    void add(phase_t phase, chrono::steady_clock::duration dur) { _cntNanos[phase] += chrono::duration_cast<chrono::nanoseconds>(dur).count(); }
+    void report(ostream &os, bool fJson) const;
+public:
+    atomic<long long> cntFiles;         // population files opened
+    atomic<long long> cntBytes;         // bytes of population read
+    atomic<long long> cntRecords;       // records parsed and counted (not those a checkpoint covers)
+    atomic<long long> cntCorrupt;       // corrupt records found (counting a file stops at the first, unless --on-corrupt=skip)
+    atomic<long long> cntGenerated;     // people generated
+    static atomic<long long> cntAllocs; // operator new calls, while fCountAllocs
+    static atomic<long long> cntAllocBytes; // bytes those calls allocated
+    static bool       fCountAllocs;     // count allocations (set before any threads are started)
+private:
+    atomic<long long> _cntNanos[ePhase_Cnt]; // wall time of each phase
+};
+atomic<long long> runStats::cntAllocs(0);
+atomic<long long> runStats::cntAllocBytes(0);
+bool              runStats::fCountAllocs = false;
+
+#if SGI_STATS && SGI_COUNT_ALLOCS
+// Every allocation is counted, while --stats asks for it; the array and sized forms forward to these
+void *operator new(size_t size)
+{
+    if (runStats::fCountAllocs)
+    {
+        runStats::cntAllocs.fetch_add(1, memory_order_relaxed);
+        runStats::cntAllocBytes.fetch_add((long long)size, memory_order_relaxed);
+    }
+    void *p = malloc(size ? size : 1);
+    if (!p)
+        throw bad_alloc();
+    return p;
+}
+#if defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // inlined, this free() pairs with the malloc() above
+#endif
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+void operator delete[](void *p) noexcept
+{
+    operator delete(p);
+}
+void operator delete(void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+void operator delete[](void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+#if defined(__GNUC__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+runStats::runStats() : cntFiles(0), cntBytes(0), cntRecords(0), cntCorrupt(0), cntGenerated(0)
+{
+    for (auto &cntNanos : _cntNanos)
+        cntNanos = 0;
+}
+
+//--------------------------------------------------------------------------
+// Name: report()
+// Desc:
+//        write the wall time of each phase, and the counters
+// Params:
+//       os    - where to write them
+//       fJson - as a single line of JSON, rather than text
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void runStats::report(ostream &os, bool fJson) const
+{
+    static const char *phaseNames[ePhase_Cnt] = { "generate", "open", "read", "count", "reduce", "report" };
+    struct { const char *pName; long long cnt; } counts[] =
+    {
+        { "files", cntFiles }, { "bytes", cntBytes }, { "records", cntRecords }, { "corrupt", cntCorrupt }, { "generated", cntGenerated },
+#if SGI_STATS && SGI_COUNT_ALLOCS
+        { "allocs", cntAllocs }, { "allocBytes", cntAllocBytes },
+#endif
+    };
+
+    if (fJson)
+    {
+        os << "{ \"seconds\": {";
+        for (int ixPhase = 0; ixPhase < ePhase_Cnt; ixPhase++)
+            os << (ixPhase ? ", \"" : " \"") << phaseNames[ixPhase] << "\": " << _cntNanos[ixPhase] / 1e9;
+        os << " }";
+        for (auto &count : counts)
+            os << ", \"" << count.pName << "\": " << count.cnt;
+        os << " }" << endl;
+        return;
+    }
+    os << "stats:" << endl;
+    for (int ixPhase = 0; ixPhase < ePhase_Cnt; ixPhase++)
+        os << "   " << phaseNames[ixPhase] << string(12 - strlen(phaseNames[ixPhase]), ' ') << _cntNanos[ixPhase] / 1e9 << " s" << endl;
+    for (auto &count : counts)
+        os << "   " << count.pName << string(12 - strlen(count.pName), ' ') << count.cnt << endl;
+}
+
+//=========================================================================
+// Name:    class corruptRecords
+// Desc:
+//          the corrupt records of a population file that --on-corrupt=skip skipped (see populationInfo::countBlock())
+//          * sampling()  - whether the next corrupt record is described (the first CORRUPT_SAMPLES are)
+//          * addSample() - the description of one of those
+//          * add()       - corrupt records skipped, sampled or not
+//          * report()    - how many were skipped, and the samples
+//          The records are found per range (or pool thread), in a side buffer, and added here in file order.
+//=========================================================================
+class corruptRecords
+{
+public:
+    #define CORRUPT_SAMPLES (10)    // corrupt records described, per file; the rest are only counted
+
+    corruptRecords() : _cnt(0) {}
+    long long count() const                      { return _cnt; }
+    bool      sampling() const                   { return _samples.size() < CORRUPT_SAMPLES; }
+    void      addSample(const string &strSample) { _samples.push_back(strSample); }
+    void      add(long long cnt)                 { _cnt += cnt; }
+    void      report(ostream &log, long long cntRecords) const;
+private:
+    long long      _cnt;            // corrupt records skipped
+    vector<string> _samples;        // descriptions of the first CORRUPT_SAMPLES of them
+};
+
+//--------------------------------------------------------------------------
+// Name: report()
+// Desc:
+//        reports how many corrupt records were skipped, and describes the samples; nothing if there were none
+// Params:
+//       log        - where to report them
+//       cntRecords - records read, including the corrupt ones
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void corruptRecords::report(ostream &log, long long cntRecords) const
+{
+    if (_cnt == 0)
+        return;
+    log << "skipped " << _cnt << " corrupt record" << (_cnt == 1 ? "" : "s") << " of " << cntRecords;
+    if ((long long)_samples.size() < _cnt)
+        log << "; the first " << _samples.size() << ":" << endl;
+    else
+        log << ":" << endl;
+    for (auto &strSample : _samples)
+        log << strSample;
+}
+
+//=========================================================================
+// Name:    class populationInfo
+// Desc:
+//          object for processing population-relevant command line arguments or commands.
+//          Includes:
+//          * generateVitalStats()    - generates a semi-realistice population data set
+//          * generateAndCountVitalStats() - generates a population data set and counts it in memory
+//          * findMaxPopulationYear() - finds and outputs the year(s) that had the most people alive (in each file, and in all of them)
+//          * runBenchmark()          - times generateVitalStats() and findMaxPopulationYear() across a matrix of options (see --bench)
+//          * serveQueries()          - loads the population once, then answers max year / per year count / range queries (see --serve)
+//=========================================================================
+class populationInfo
+{
+public:
+    populationInfo(weak_ptr<argsAndErrs_t>  wpFb);
+    void generateVitalStats(yearCounter *pCounter=nullptr);
+    void generateAndCountVitalStats();
+    void findMaxPopulationYear();
+    void runBenchmark();
+    void serveQueries();
+    void reportStats();
+private:
+    enum { eFileTokenFName, eFileTokenLName, eFileTokenBYear, eFileTokenDYear };
+    vector<string> deliminatedStringToTokens(const string &inpStr);
+    bool           parseRecord(const char *pRec, const char *pRecEnd, const yearRange_t &range, int &yrBirth, int &yrDeath) const;
+    inline bool    decodeRecord(argsAndErrs::parser_t parser, const yearRange_t &range, const char *pRec, const char *pRecEnd, int &yrBirth, int &yrDeath);
+    template <int WIDTH>
+    bool           countRecords(argsAndErrs::parser_t parser, yearCounter &counter, const char *pBlk, const char *pBlkEnd,
+                                long long &cntRecords, const char *&pRecBad, const char *&pRecBadEnd);
+    static inline bool parseYear(const char *p, const char *pEnd, int &yr);
+    static bool        parseYearField(const char *p, const char *pEnd, int &yr);
+    template <int WIDTH>
+    bool           countIndexedRecords(yearCounter &counter, const char *pBlk, const char *pBlkEnd,
+                                       long long &cntRecords, const char *&pRecBad, const char *&pRecBadEnd);
+    template <int WIDTH>
+    bool           countBinaryRecords(const binaryHeader_t &header, yearCounter &counter, const char *pBlk, const char *pBlkEnd,
+                                      long long &cntRecords, const char *&pRecBad, const char *&pRecBadEnd);
+    bool           countRange(argsAndErrs::parser_t parser, const binaryHeader_t *pHeader, yearCounter &counter, const char *pBeg, const char *pEnd,
+                              long long &cntRecords, const char *&pRecBad, const char *&pRecBadEnd);
+    struct badRecord_t { long long ixRecord; const char *pRec; const char *pRecEnd; }; // a corrupt record; ixRecord is 1 based, within its range
+    void           countRangeSkipping(argsAndErrs::parser_t parser, const binaryHeader_t *pHeader, yearCounter &counter, const char *pBeg, const char *pEnd,
+                                      bool fSkip, long long &cntRecords, long long &cntBad, vector<badRecord_t> &bads);
+    bool           countBlock(shared_ptr<argsAndErrs_t> &pFB, workPool *pPool, const binaryHeader_t *pHeader, yearCounter &counter,
+                              const char *pBlk, const char *pBlkEnd, unsigned long long offBlk, long long &ixRecord, corruptRecords *pCorrupt, stringstream &ssErr);
+    bool           countFile(shared_ptr<argsAndErrs_t> &pFB, workPool *pPool, const string &strFile, yearCounter &counter,
+                             long long &ixRecord, corruptRecords *pCorrupt, ostream &log, stringstream &ssErr);
+    void           countFiles(shared_ptr<argsAndErrs_t> &pFB);
+    bool           openPopulation(shared_ptr<argsAndErrs_t> &pFB, workPool *pPool, const string &strFile, size_t sizeRead, unique_ptr<populationReader> &pReader,
+                                  binaryHeader_t &header, binaryHeader_t *&pHeader, stringstream &ssErr);
+    bool           loadStore(shared_ptr<argsAndErrs_t> &pFB, const string &strFile, populationStore &store, long long &ixRecord,
+                             corruptRecords *pCorrupt, stringstream &ssErr);
+    bool           storeRecords(argsAndErrs::parser_t parser, const binaryHeader_t *pHeader, populationStore &store, const char *pBlk, const char *pBlkEnd,
+                                unsigned long long offBlk, long long &ixRecord, corruptRecords *pCorrupt, stringstream &ssErr);
+    void           storeNamedPerson(populationStore &store, int yrBirth, int yrDeath, const char *pRec, const char *pRecEnd);
+    void           describeCorruptRecord(stringstream &ss, argsAndErrs::parser_t parser, const yearRange_t &range, const binaryHeader_t *pHeader,
+                                       long long ixRecord, const char *pRec, const char *pRecEnd, long long offRecord=-1);
+    void           skipCorruptRecord(corruptRecords &corrupt, argsAndErrs::parser_t parser, const yearRange_t &range, const binaryHeader_t *pHeader,
+                                     long long ixRecord, const char *pRec, const char *pRecEnd, unsigned long long offRecord);
+    void           describeBadBinaryFile(stringstream &ss, const string &strFile, const string &strWhy);
+    void           describeUnreadableFile(stringstream &ss, const string &strFile);
+    void           describeUnreadableData(stringstream &ss, const string &strFile, long long ixRecord, const char *pWhy);
+    void           reportFileErr(shared_ptr<argsAndErrs_t> &pFB, stringstream &ss);
+    void           reportMaxYears(const string &strWhat, yearCounter &counter);
+    void           reportDistribution(shared_ptr<argsAndErrs_t> &pFB, const yearCounter &counter);
+    bool           writeHistogram(const string &strFile, const yearCounter &counter);
+    bool           loadCheckpoint(const string &strFile, const string &strCkpt, yearCounter &counter, unsigned long long offRecords, size_t sizeRecord,
+                                  unsigned long long &offResume, long long &cntRecords, bool fFull, prefixHash &hash, ostream &log);
+    void           saveCheckpoint(const string &strFile, const string &strCkpt, const yearCounter &counter, unsigned long long offRecords,
+                                  unsigned long long offEnd, long long cntRecords, const prefixHash &hash, ostream &log);
+    bool           generateShards(shared_ptr<argsAndErrs_t> &pFB, vector<yearCounter> *pCounters);
+    void           generateStreams(ofstream *pOutStream, bool fBinary, argsAndErrs::compress_t codec, const yearRange_t &range, unsigned long long seed, int cntThreads, long long populationSize,
+                                   vector<yearCounter> *pCounters);
+    void           generatePeople(xoshiro256 &rng, const yearRange_t &range, vector<vitalStats_t> &vPopulationStats, long long populationSize);
+    void           writeTextRecords(outputBuffer &out, const vector<vitalStats_t> &vPopulationStats);
+    void           writeBinaryHeader(outputBuffer &out, const yearRange_t &range, long long cntRecords);
+    void           writeBinaryRecords(outputBuffer &out, const yearRange_t &range, const vector<vitalStats_t> &vPopulationStats);
+    double         benchCase(const argsAndErrs_t &args, long long &cntPeakRssKB);
+    bool           answerQuery(populationStore &store, yearIndex &index, yearCounter &subset, yearRange_t &bornSubset,
+                               const string &strQuery, string &strAnswer);
+    static void    resetPeakRss();
+    static long long peakRssKB();
+    static long long fileSize(const string &strFile);
+    static string  jsonString(const string &str);
+private:
+    weak_ptr<argsAndErrs_t> _wpFb;      // hasa argsAndErrs_t
+    const char              _delim;     // intra-record delimiter used to generate and parse data set info.
+    runStats                _stats;     // where the time goes (see --stats)
+    runStats               *_pStats;    // &_stats with --stats; nullptr otherwise (nothing is timed)
+};
+
+populationInfo::populationInfo(weak_ptr<argsAndErrs_t> wpFb) : _delim(';'), _pStats(nullptr)
+{
+    _wpFb = wpFb;
+    shared_ptr<argsAndErrs_t> pFB = _wpFb.lock();
+    if (pFB && pFB->stats() != argsAndErrs::eStats_Off)
+    {
+        _pStats = &_stats;
+        runStats::fCountAllocs = true;
+    }
+}
+
+argsAndErrs::argsAndErrs()
+  : _sizeOfPopulation(-1),
+    _countEngine(eCountEngine_DiffArray),
+    _argMax(eArgMax_Deferred),
+    _parser(eParser_Fast),
+    _onCorrupt(eOnCorrupt_Stop),
+    _reader(eReader_Mmap),
+    _format(eFormat_Text),
+    _generator(eGenerator_Stream),
+    _compress(eCompress_None),
+    _cntShards(0),
+    _fused(eFused_Off),
+    _fYearRangeSet(false),
+    _fCheckpoint(false),
+    _checkpointVerify(eCheckpointVerify_Edges),
+    _fBench(false),
+    _stats(eStats_Off),
+    _fStore(false),
+    _names(eNames_Off),
+    _fServe(false),
+    _cntTop(0)
+{
+    _cntThreads = max(1, (int)thread::hardware_concurrency());
+    _seed       = (unsigned long long)time(nullptr);
+}
+
+//--------------------------------------------------------------------------
+// Name: initWithArgs()
+// Desc:
+//      * Accept input stings (putting them into m_args list)
+//      * population file
+//      * optional size of population (will generate a file)
+//      * optional '--name=value' options (may appear anywhere after the application path)
+// Params:
+//       argc   - number of arguments
+//       argv   - array of argument strings
+//       strErr - if error, message to output
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool argsAndErrs::initWithArgs(int argc, const char * argv[], string &strErr)
+{
+    // Accept input stings (putting them into m_args list)
+    for (int ix = eCmdLnArg_AppPath; ix < argc; ix++)
+    {
+        _args.push_back(argv[ix]);
+    }
+
+    bool fDoBreak = false;
+    do
+    {
+        // Options are pulled out first, so the positional args keep their eCmdLnArg_ index
+        vector<const char *> posArgs;
+        for (int ix = eCmdLnArg_AppPath; ix < argc; ix++)
+        {
+            string strArg = argv[ix];
+            if (ix > eCmdLnArg_AppPath && strArg.compare(0, 2, "--") == 0)
+            {
+                if (( fDoBreak = initOption(strArg, strErr) ))
+                    break;
+            }
+            else
+                posArgs.push_back(argv[ix]);
+        }
+        if (fDoBreak)
+            break;
+
+        // More than one population file (or a glob matching more than one): count them all (see populationFiles()).
+        // Only a 2nd arg that is a glob pattern, or an existing file that isn't a number, starts the list; anything
+        // else is the population size (or one arg too many), and is reported as such by the switch below.
+        // A file named like a number is given as a path (e.g. ./100)
+        int  cntPosArgs = (int)posArgs.size();
+        bool fFiles     = cntPosArgs <= eCmdLnArg_PopSize;
+        if (!fFiles)
+        {
+            string strArg  = posArgs[eCmdLnArg_PopSize];
+            bool   fNumber = strArg.size() && strArg.find_first_not_of("+-0123456789") == string::npos;
+            fFiles = strArg.find_first_of("*?[") != string::npos || (!fNumber && ifstream(strArg.c_str()).is_open());
+        }
+        for (int ixCmdLnArg = eCmdLnArg_PopFile; ixCmdLnArg < cntPosArgs && fFiles; ixCmdLnArg++)
+            addPopulationFiles(posArgs[ixCmdLnArg]);
+        if (_filesPopulation.size())
+            _filePopulation = _filesPopulation[0];
+        if (_filesPopulation.size() > 1)
+            cntPosArgs = eCmdLnArg_PopFile; // nothing left for the switch; each file is checked below
+        else
+            _filesPopulation.clear();
+
+        for (int ixCmdLnArg = eCmdLnArg_PopFile; ixCmdLnArg < cntPosArgs; ixCmdLnArg++)
+        {
+            switch (ixCmdLnArg)
+            {
+                case eCmdLnArg_PopFile:
+                    if (_filePopulation.empty())
+                        _filePopulation = posArgs[eCmdLnArg_PopFile];
+                    break;
+                case eCmdLnArg_PopSize:
+                    if (cntPosArgs == eCmdLnArg_PopSize+1)
+                    {
+                        _sizeOfPopulation = 0;
+                        try
+                        {
+                            size_t cntParsed  = 0;
+                            _sizeOfPopulation = stoll(posArgs[eCmdLnArg_PopSize], &cntParsed);
+                            if (posArgs[eCmdLnArg_PopSize][cntParsed] != '\0')
+                                throw invalid_argument("trailing characters");
+                        }
+                        catch (...)
+                        {
+                            stringstream ss;
+                            ss <<  "    Problem with argment[" << ixCmdLnArg << "]." << endl;
+                            ss <<  "        '"<<posArgs[ixCmdLnArg]<<"'. Needs to be a valid integer, specifying the desired population size." << endl;
+                            addCmdLnArgsToErr(ss);
+                            strErr = ss.str();
+                            fDoBreak = true;
+                        }
+                    }
+                    break;
+                default:
+                    {
+                        stringstream ss;
+                        ss <<  "    Too many CmdLineArgs." << endl;
+                        addCmdLnArgsToErr(ss);
+                        strErr = ss.str();
+                        fDoBreak = true;
+                    }
+                    break;
+            }
+        }
+        if (fDoBreak)
+            break;
+        
+        if (fromStdin() && _fCheckpoint)
+        {
+            stringstream ss;
+            ss <<  "    Problem with option '--checkpoint'." << endl;
+            ss <<  "        stdin ('" STDIN_FILE_NAME "') can not be resumed from a checkpoint; it is not a file that is appended to." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        if (_filesPopulation.size() && (_fileCheckpoint.size() || find(_filesPopulation.begin(), _filesPopulation.end(), STDIN_FILE_NAME) != _filesPopulation.end()))
+        {
+            stringstream ss;
+            ss <<  "    Problem with the population files." << endl;
+            ss <<  "        When counting several files, each has its own checkpoint (--checkpoint, without =FILE), and none can be stdin ('" STDIN_FILE_NAME "')." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        for (auto &strFile : _filesPopulation)
+        {
+            ifstream file(strFile.c_str());
+            if (!file.is_open())
+            {
+                stringstream ss;
+                ss <<  "    Problem with the population files." << endl;
+                ss <<  "        '"<<strFile<<"' does not exist." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+                break;
+            }
+        }
+        if (fDoBreak)
+            break;
+        if (_fServe && (_fCheckpoint || _filesPopulation.size() || fromStdin() || _sizeOfPopulation != -1 || _fBench))
+        {
+            stringstream ss;
+            ss <<  "    Problem with option '--serve'." << endl;
+            ss <<  "        Loads a single, existing, populationFile (not stdin, which is where the queries are read from); it can not" << endl;
+            ss <<  "        be used with several files, a size to generate, --checkpoint or --bench." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        if (_compress != eCompress_None && (_sizeOfPopulation == -1 || fromStdin() || _fused == eFused_Count || _fBench))
+        {
+            stringstream ss;
+            ss <<  "    Problem with option '--compress'." << endl;
+            ss <<  "        Compresses a populationFile that is generated (and written, not just --fused); a compressed" << endl;
+            ss <<  "        populationFile that is read is detected by its magic." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        if (_cntShards && (_sizeOfPopulation == -1 || fromStdin() || _generator == eGenerator_Vector || _fused == eFused_Count || _fBench))
+        {
+            stringstream ss;
+            ss <<  "    Problem with option '--shards'." << endl;
+            ss <<  "        Shards a populationFile that is generated (and written, not just --fused), with --generator=stream;" << endl;
+            ss <<  "        a manifest that is read is always counted shard by shard." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        if (_checkpointVerify != eCheckpointVerify_Edges && !_fCheckpoint)
+        {
+            stringstream ss;
+            ss <<  "    Problem with option '--checkpoint-verify'." << endl;
+            ss <<  "        Chooses how a checkpoint is checked before resuming from it; it needs --checkpoint." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        if (_names != eNames_Off && !_fStore && !_fServe)
+        {
+            stringstream ss;
+            ss <<  "    Problem with option '--names'." << endl;
+            ss <<  "        Keeps the names of a populationFile that is loaded into memory; it needs --store or --serve." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        if (_fStore && (_fCheckpoint || _filesPopulation.size()))
+        {
+            stringstream ss;
+            ss <<  "    Problem with option '--store'." << endl;
+            ss <<  "        Loads a single populationFile into memory, all of it; it can not be used with several files, or --checkpoint." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        if (_fBench && (_sizeOfPopulation != -1 || _filesPopulation.size() || fromStdin() || _filePopulation.empty()))
+        {
+            stringstream ss;
+            ss <<  "    Problem with option '--bench'." << endl;
+            ss <<  "        Needs a single populationFile to generate into (not stdin); the population sizes are given with --bench=N,N..." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        if (fromStdin() && _sizeOfPopulation != -1 && _fused != eFused_Count)
+        {
+            stringstream ss;
+            ss <<  "    Problem with argment[" << eCmdLnArg_PopFile << "]." << endl;
+            ss <<  "        '" STDIN_FILE_NAME "' (stdin) can only be read; a generated population needs a file name (or --fused)." << endl;
+            addCmdLnArgsToErr(ss);
+            strErr = ss.str();
+            fDoBreak = true;
+            break;
+        }
+        if (_sizeOfPopulation == -1 && !fromStdin() && _filesPopulation.empty() && !_fBench)
+        {
+            // ensure the file exists
+            ifstream file;
+            file.open (_filePopulation.c_str());
+            if (file.is_open())
+                file.close();
+            else if (cntPosArgs > eCmdLnArg_PopFile)
+            {
+                stringstream ss;
+                ss <<  "    Problem with argment[" << eCmdLnArg_PopFile << "]." << endl;
+                ss <<  "        '"<<posArgs[eCmdLnArg_PopFile]<<"' does not exist." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            else
+            {
+                stringstream ss;
+                ss <<  "    This program requires at least 1 argment (name of population file)" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+        }
+    } while (false);
+    
+    
+    return fDoBreak;
+} //initWithArgs()
+
+//--------------------------------------------------------------------------
+// Name: initOption()
+// Desc:
+//      Accept a single '--name=value' command line option
+// Params:
+//       strOpt - the option, as typed on the command line
+//       strErr - if error, message to output
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool argsAndErrs::initOption(const string &strOpt, string &strErr)
+{
+    size_t posEq   = strOpt.find('=');
+    string strName = strOpt.substr(2, (posEq == string::npos) ? string::npos : posEq-2);
+    string strVal  = (posEq == string::npos) ? "" : strOpt.substr(posEq+1);
+
+    bool fDoBreak = false;
+    do
+    {
+        if (strName == "engine")
+        {
+            if      (strVal == "peryear") _countEngine = eCountEngine_PerYear;
+            else if (strVal == "diff")    _countEngine = eCountEngine_DiffArray;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --engine=diff, --engine=peryear" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "argmax")
+        {
+            if      (strVal == "inline")   _argMax = eArgMax_Inline;
+            else if (strVal == "deferred") _argMax = eArgMax_Deferred;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --argmax=deferred, --argmax=inline" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "parser")
+        {
+            if      (strVal == "fast")   _parser = eParser_Fast;
+            else if (strVal == "tokens") _parser = eParser_Tokens;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --parser=fast, --parser=tokens" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "on-corrupt")
+        {
+            if      (strVal == "stop") _onCorrupt = eOnCorrupt_Stop;
+            else if (strVal == "skip") _onCorrupt = eOnCorrupt_Skip;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --on-corrupt=stop, --on-corrupt=skip" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "reader")
+        {
+            if      (strVal == "mmap")     _reader = eReader_Mmap;
+            else if (strVal == "buffered") _reader = eReader_Buffered;
+            else if (strVal == "stream")   _reader = eReader_Stream;
+            else if (strVal == "async")    _reader = eReader_Async;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --reader=mmap, --reader=buffered, --reader=stream, --reader=async" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "format")
+        {
+            if      (strVal == "text")   _format = eFormat_Text;
+            else if (strVal == "binary") _format = eFormat_Binary;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --format=text, --format=binary" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "generator")
+        {
+            if      (strVal == "stream") _generator = eGenerator_Stream;
+            else if (strVal == "vector") _generator = eGenerator_Vector;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --generator=stream, --generator=vector" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "fused")
+        {
+            if      (strVal == "" || strVal == "count") _fused = eFused_Count;
+            else if (strVal == "tee")                   _fused = eFused_Tee;
+            else if (strVal == "off")                   _fused = eFused_Off;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --fused, --fused=tee, --fused=off" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "seed")
+        {
+            try
+            {
+                size_t cntUsed = 0;
+                _seed = stoull(strVal, &cntUsed);
+                if (cntUsed != strVal.size())
+                    throw false;
+            }
+            catch (...)
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be a non-negative integer, seeding the generated population." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "top")
+        {
+            try
+            {
+                size_t cntUsed = 0;
+                long long cntTop = stoll(strVal, &cntUsed);
+                if (cntUsed != strVal.size() || cntTop < 1)
+                    throw false;
+                _cntTop = (size_t)cntTop;
+            }
+            catch (...)
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be a positive integer, the number of most populous years to report." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "histogram")
+        {
+            if (strVal.empty())
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be --histogram=FILE, the file to write the population of every year to." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            _fileHistogram = strVal;
+            break;
+        }
+        if (strName == "serve")
+        {
+            _fServe = true;
+            break;
+        }
+        if (strName == "store")
+        {
+            _fStore = true;
+            break;
+        }
+        if (strName == "names")
+        {
+            if      (strVal == "" || strVal == "intern") _names = eNames_Intern;
+            else if (strVal == "copy")                   _names = eNames_Copy;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --names, --names=intern, --names=copy" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "stats")
+        {
+            if      (strVal == "" || strVal == "text") _stats = eStats_Text;
+            else if (strVal == "json")                 _stats = eStats_Json;
+            else if (strVal == "off")                  _stats = eStats_Off;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --stats, --stats=json, --stats=off" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "bench")
+        {
+            try
+            {
+                _fBench = true;
+                _benchSizes.clear();
+                if (strVal.empty())
+                    _benchSizes = BENCH_SIZES;
+                for (size_t posBeg = 0; posBeg < strVal.size(); )
+                {
+                    size_t posEnd = strVal.find(',', posBeg);
+                    string strSize = strVal.substr(posBeg, (posEnd == string::npos) ? string::npos : posEnd-posBeg);
+                    size_t cntUsed = 0;
+                    long long size = stoll(strSize, &cntUsed);
+                    if (cntUsed != strSize.size() || size < 1)
+                        throw false;
+                    _benchSizes.push_back(size);
+                    posBeg = (posEnd == string::npos) ? strVal.size() : posEnd+1;
+                }
+                if (_benchSizes.empty())
+                    throw false;
+            }
+            catch (...)
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be a comma separated list of positive integers, the population sizes to benchmark." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "compress")
+        {
+            if      (strVal == "gzip") _compress = eCompress_Gzip;
+            else if (strVal == "zstd") _compress = eCompress_Zstd;
+            else if (strVal == "off")  _compress = eCompress_None;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --compress=gzip, --compress=zstd, --compress=off" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+                break;
+            }
+            if (!frameCodec::supported(_compress))
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        This build can not write " << frameCodec::name(_compress) << "; rebuild with "
+                   << ((_compress == eCompress_Gzip) ? "-DSGI_WITH_ZLIB=1 -lz" : "-DSGI_WITH_ZSTD=1 -lzstd") << "." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "shards")
+        {
+            try
+            {
+                size_t cntUsed = 0;
+                _cntShards = stoi(strVal, &cntUsed);
+                if (cntUsed != strVal.size() || _cntShards < 1 || _cntShards > MAX_SHARDS)
+                    throw false;
+            }
+            catch (...)
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be an integer from 1 to " << MAX_SHARDS << ", the number of shard files to write." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "checkpoint")
+        {
+            _fCheckpoint    = true;
+            _fileCheckpoint = strVal;
+            break;
+        }
+        if (strName == "checkpoint-verify")
+        {
+            if      (strVal == "edges") _checkpointVerify = eCheckpointVerify_Edges;
+            else if (strVal == "full")  _checkpointVerify = eCheckpointVerify_Full;
+            else
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be one of: --checkpoint-verify=edges, --checkpoint-verify=full" << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+        if (strName == "years")
+        {
+            if (parseYearRange(strVal, _yearRange))
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be BEG-END, the first and last years (0 <= BEG <= END <= " << MAX_YEAR << ")." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+                break;
+            }
+            _fYearRangeSet = true;
+            break;
+        }
+        if (strName == "threads")
+        {
+            try
+            {
+                size_t cntUsed = 0;
+                _cntThreads = stoi(strVal, &cntUsed);
+                if (cntUsed != strVal.size() || _cntThreads < 1)
+                    throw false;
+            }
+            catch (...)
+            {
+                stringstream ss;
+                ss <<  "    Problem with option '" << strOpt << "'." << endl;
+                ss <<  "        Needs to be a positive integer, specifying the number of worker threads." << endl;
+                addCmdLnArgsToErr(ss);
+                strErr = ss.str();
+                fDoBreak = true;
+            }
+            break;
+        }
+
+        stringstream ss;
+        ss <<  "    Unknown option '" << strOpt << "'." << endl;
+        addCmdLnArgsToErr(ss);
+        strErr = ss.str();
+        fDoBreak = true;
+    } while (false);
+
+    return fDoBreak;
+} // initOption()
+
+//--------------------------------------------------------------------------
+// Name: parseYearRange()
+// Desc:
+//      parse the first and last years of a range, 'BEG-END' (0 <= BEG <= END <= MAX_YEAR)
+// Params:
+//       strVal - the range
+//       range  - the parsed range (unchanged, if error)
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool argsAndErrs::parseYearRange(const string &strVal, yearRange_t &range)
+{
+    try
+    {
+        size_t posDash = strVal.find('-');
+        size_t cntUsedBeg = 0;
+        size_t cntUsedEnd = 0;
+        if (posDash == string::npos)
+            return true;
+        string strBeg = strVal.substr(0, posDash);
+        string strEnd = strVal.substr(posDash+1);
+        int yrBeg = stoi(strBeg, &cntUsedBeg);
+        int yrEnd = stoi(strEnd, &cntUsedEnd);
+        if (cntUsedBeg != strBeg.size() || cntUsedEnd != strEnd.size() || yrBeg < 0 || yrBeg > yrEnd || yrEnd > MAX_YEAR)
+            return true;
+        range = yearRange_t(yrBeg, yrEnd);
+    }
+    catch (...)
+    {
+        return true;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: addPopulationFiles()
+// Desc:
+//      add a population file to count (see populationFiles()); a glob pattern adds every file it matches
+//      (except checkpoints), and a manifest (see --shards) adds its shards
+// Params:
+//       strArg - file name or glob pattern
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void argsAndErrs::addPopulationFiles(const string &strArg)
+{
+#ifndef _WIN32
+    glob_t globbed;
+    if (strArg.find_first_of("*?[") != string::npos && glob(strArg.c_str(), 0, nullptr, &globbed) == 0)
+    {
+        // A checkpoint next to its population file (see --checkpoint) is not a population file
+        string strExt = CHECKPOINT_FILE_EXT;
+        for (size_t ixPath = 0; ixPath < globbed.gl_pathc; ixPath++)
+        {
+            string strPath = globbed.gl_pathv[ixPath];
+            if (strPath.size() < strExt.size() || strPath.compare(strPath.size() - strExt.size(), strExt.size(), strExt) != 0)
+                addPopulationFiles(strPath);
+        }
+        globfree(&globbed);
+        return;
+    }
+#endif
+    vector<string> shards;
+    if (strArg != STDIN_FILE_NAME && !readManifest(strArg, shards))
+    {
+        _filesPopulation.insert(_filesPopulation.end(), shards.begin(), shards.end());
+        return;
+    }
+    _filesPopulation.push_back(strArg);
+}
+
+//--------------------------------------------------------------------------
+// Name: countShards()
+// Desc:
+//      once the shards of populationFile have been generated (see --shards), count them in its place, as if its
+//      manifest had been given (see addPopulationFiles())
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void argsAndErrs::countShards()
+{
+    vector<string> shards;
+    if (readManifest(_filePopulation, shards))
+        return;
+    _filePopulation  = shards[0];
+    _filesPopulation = shards;
+    if (_filesPopulation.size() == 1)
+        _filesPopulation.clear(); // a single file is counted on its own
+}
+
+//--------------------------------------------------------------------------
+// Name: readManifest()
+// Desc:
+//      read a manifest (see --shards): a MANIFEST_MAGIC line, then a 'records shardFile' line per shard.
+//      Each shard file is relative to the manifest's directory
+// Params:
+//       strFile - the file, which may or may not be a manifest
+//       shards  - the shard files
+// Returns:
+//      false if success; true if the file is not a manifest (or lists no shards)
+//--------------------------------------------------------------------------
+bool argsAndErrs::readManifest(const string &strFile, vector<string> &shards)
+{
+    ifstream file(strFile.c_str());
+    string   strLine;
+    if (!file.is_open() || !getline(file, strLine) || strLine != MANIFEST_MAGIC)
+        return true;
+
+    size_t posDir = strFile.find_last_of("/\\");
+    string strDir = (posDir == string::npos) ? "" : strFile.substr(0, posDir+1);
+    shards.clear();
+    while (getline(file, strLine))
+    {
+        size_t posName = strLine.find(' ');
+        if (posName == string::npos || posName+1 == strLine.size())
+            continue;
+        string strShard = strLine.substr(posName+1);
+        shards.push_back((strShard[0] == '/') ? strShard : strDir + strShard);
+    }
+    return shards.empty();
+}
+
+//--------------------------------------------------------------------------
+// Name: reportErr()
+// Desc:
+//      output out an error message to std out
+//      * Error Message (if any) is prefixed with an application usage message
+// Params:
+//       strErr - error message to output
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void argsAndErrs::reportErr(string strErr/*""*/)
+{
+    #define PATH_U_DELIM ('/')
+    #define PATH_W_DELIM ('\\')
+    #define PATH_C_DELIM (':')
+    
+    // trim application path
+    static char PATH_DELIMS[] = { PATH_U_DELIM, PATH_W_DELIM, PATH_C_DELIM };
+    string appName = _args.size() ? *_args.begin() : "<NoAppName>";
+    size_t posPathDelim = appName.find_last_of(PATH_DELIMS);
+    if(string::npos != posPathDelim)
+    {
+        appName = appName.substr(posPathDelim+1);
+    }
+    
+    cerr << endl;
+    cerr << "Description:" << endl;
+    cerr << "   This program allows the user to " << endl;
+    cerr << "   a) Generate a population file, including the birth & death years of each person." << endl;
+    cerr << "   b) Process the file and report the year that the maximum number of people were alive." << endl;
+    cerr << "      If the maximum occurs in multile years, all years will be reported." << endl;
+    cerr << endl;
+    cerr << "Usage: " << appName << " populationFile [sizeOfPopulationToGenerate] [options]" << endl;
+    cerr << "   Where " << endl;
+    cerr << "      'populationFile'             is the file to read from or write to," << endl;
+    cerr << "                                   '" STDIN_FILE_NAME "' reads the population from stdin (e.g. a pipe)," << endl;
+    cerr << "      'sizeOfPopulationToGenerate' is an integer specifying the number of records to generate for the file." << endl;
+    cerr << "   If no population size is specified, this program will simply read and process the populationFile."  << endl;
+    cerr << endl;
+    cerr << "   Or:  " << appName << " populationFile populationFile... [options]" << endl;
+    cerr << "   Counts every file (a quoted glob, e.g. 'data/*.txt', is expanded too) on a shared pool of --threads," << endl;
+    cerr << "   reporting each file, then all of them together." << endl;
+    cerr << endl;
+    cerr << "Options:" << endl;
+    cerr << "   --engine=diff|peryear   how each person's alive years are counted (default: diff)" << endl;
+    cerr << "                              diff    - +1 at birth, -1 after death, then one prefix-sum pass" << endl;
+    cerr << "                              peryear - increment every year the person is alive" << endl;
+    cerr << "   --argmax=deferred|inline when the peryear engine finds the most populous year(s) (default: deferred)" << endl;
+    cerr << "                              deferred - one scan of the yearly counts after the file has been read" << endl;
+    cerr << "                              inline   - track the maximum as every count is incremented" << endl;
+    cerr << "   --parser=fast|tokens    how each record's years are decoded (default: fast)" << endl;
+    cerr << "                              fast   - decode the years in place, skipping the names, without allocating" << endl;
+    cerr << "                              tokens - split the record into strings and stoi() the years" << endl;
+    cerr << "                              both accept 'first;last;birth;death' records: each year is [spaces][sign]digits" << endl;
+    cerr << "                              [anything]; any more fields are ignored; birth <= death, both within --years" << endl;
+    cerr << "   --on-corrupt=stop|skip  what a corrupt record does (default: stop)" << endl;
+    cerr << "                              stop - report it, and count nothing" << endl;
+    cerr << "                              skip - count the others; report how many were skipped, and the first " << CORRUPT_SAMPLES << endl;
+    cerr << "                                     (with their record index and byte offset)" << endl;
+    cerr << "   --reader=mmap|buffered|stream|async  how populationFile is read (default: mmap)" << endl;
+    cerr << "                              mmap     - map the file and parse it in place (async, where it can not be mapped)" << endl;
+    cerr << "                              buffered - large read()s, parsed in place" << endl;
+    cerr << "                              stream   - ifstream + getline(), one line at a time, into memory (see --store)" << endl;
+    cerr << "                              async    - large read()s on a reader thread, " << ASYNC_BUFFERS << " in flight, parsed in place" << endl;
+    cerr << "                                         while the next ones are read (e.g. network storage)" << endl;
+    cerr << "                              stdin ('" STDIN_FILE_NAME "') is always read with large reads (async, unless --reader=buffered)" << endl;
+    cerr << "   --threads=N             worker threads counting the mmap/buffered input, or generating people (default: all cores)" << endl;
+    cerr << "   --format=text|binary    format of a generated populationFile (default: text)" << endl;
+    cerr << "                              binary - header + 2 bytes per person; detected automatically when read" << endl;
+    cerr << "   --generator=stream|vector  how people are generated (default: stream)" << endl;
+    cerr << "                              stream - generate and write in bounded batches; memory use stays constant" << endl;
+    cerr << "                              vector - generate the whole population before writing it, on a single thread" << endl;
+    cerr << "   --seed=N                seed of the generated population (default: the current time)" << endl;
+    cerr << "                              The same seed, --threads and --generator always generate the same file" << endl;
+    cerr << "   --fused[=tee]           count the generated people in memory, instead of writing and re-reading populationFile" << endl;
+    cerr << "                              tee - still write populationFile" << endl;
+    cerr << "   --years=BEG-END         first and last years generated and counted (default: " << RANGE_YEAR_BEG << "-" << RANGE_YEAR_END << ")" << endl;
+    cerr << "                              a binary populationFile records its years; they are used unless --years is given" << endl;
+    cerr << "   --compress=gzip|zstd    compress a generated populationFile (and each of its --shards) as independently" << endl;
+    cerr << "                              compressed frames, which are decompressed in parallel when it is read;" << endl;
+    cerr << "                              a gzip or zstd populationFile is always detected when read (if the build supports it)" << endl;
+    cerr << "   --shards=N              write a generated population as N shard files (populationFile.000, ...), each on its own" << endl;
+    cerr << "                              thread, and populationFile as their manifest; a manifest is counted as its shards" << endl;
+    cerr << "   --checkpoint[=FILE]     count only the records appended to populationFile since the last run (default FILE:" << endl;
+    cerr << "                              populationFile" CHECKPOINT_FILE_EXT "); a changed, already counted part of the file recounts it all" << endl;
+    cerr << "   --checkpoint-verify=edges|full  how a checkpoint is checked before resuming from it (default: edges)" << endl;
+    cerr << "                              edges - the file's inode, and the first and last 64KB it covers; reads O(appended)" << endl;
+    cerr << "                              full  - also hash all the bytes it covers (a read of the whole file), to catch any change" << endl;
+    cerr << "   --top=K                 also report the K most populous years, most people alive first" << endl;
+    cerr << "   --histogram=FILE        write the population of every year to FILE: CSV (year,alive), or binary if FILE ends" << endl;
+    cerr << "                              with .bin (see writeHistogram()); several files write their combined population" << endl;
+    cerr << "   --store                 load populationFile into memory, as a column of birth and one of death years, then count" << endl;
+    cerr << "                              it (--reader=stream always does)" << endl;
+    cerr << "   --names[=intern|copy]   with --store or --serve, also keep each person's first and last names, in one buffer" << endl;
+    cerr << "                              intern - each distinct name once (default); copy - every person's names" << endl;
+    cerr << "   --serve                 load populationFile into memory and count it once, then answer queries, one per line on" << endl;
+    cerr << "                              stdin, one line each on stdout ('ok ...' or 'error ...'), until 'quit' or end of input:" << endl;
+    cerr << "                              max [BEG-END] [born=BEG-END]  - most people alive (in years BEG to END), and the year(s)" << endl;
+    cerr << "                              count YEAR [born=BEG-END]     - people alive in YEAR" << endl;
+    cerr << "                              range BEG-END [born=BEG-END]  - people alive in each year BEG to END" << endl;
+    cerr << "                              add BIRTH DEATH               - add a person (remove BIRTH DEATH removes one)" << endl;
+    cerr << "                              name FIRST;LAST               - people with these names (see --names), and the years of" << endl;
+    cerr << "                                                              the first " << SERVE_NAME_MATCHES << endl;
+    cerr << "                              info                          - records and years loaded" << endl;
+    cerr << "                              born=BEG-END only counts the people born in those years" << endl;
+    cerr << "   --stats[=json]          report the wall time of each phase (open, read, count, reduce, report), the bytes, records" << endl;
+    cerr << "                              and corrupt records read, to stderr (as JSON); a -DSGI_COUNT_ALLOCS=1 build also counts" << endl;
+    cerr << "                              the allocations (it replaces the global operator new/delete)" << endl;
+    cerr << "   --bench[=N,N...]        generate populationFile with N people (default: 100000,1000000), then count it, for every" << endl;
+    cerr << "                              --parser, --engine and thread count (1, 2, 4, ... --threads); reports JSON to stdout" << endl;
+    cerr << endl;
+    if (strErr.length())
+    {
+        cerr << "Error: " << endl;
+        cerr << strErr;
+    }
+} // reportErr()
+
+
+//--------------------------------------------------------------------------
+// Name: addCmdLnArgsToErr()
+// Desc:
+//      add the (post application name) Command Line Args to the current stream
+// Params:
+//       ss - output string stream to append to
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void argsAndErrs::addCmdLnArgsToErr(stringstream &ss)
+{
+    size_t ix=eCmdLnArg_AppPath;
+    for (auto itCmdLnArg = _args.begin(); itCmdLnArg != _args.end(); ++itCmdLnArg)
+        ss <<  "        param[" << ix++ << "] = " << *itCmdLnArg << endl;
+} // addCmdLnArgsToErr()
+
+
+
+
+//--------------------------------------------------------------------------
+// Name: generateVitalStats()
+// Desc:
+//       Generate semi-realistic birth death years for people living in the desired time frame (--years=, RANGE_YEAR_BEG to RANGE_YEAR_END by default)
+//       (see generatePeople()) and write them to the population file.
+//       With eGenerator_Stream, people are generated and written in bounded batches, so memory use does not grow
+//       with the population size; eGenerator_Vector generates the whole population before writing any of it.
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::generateVitalStats(yearCounter *pCounter/*nullptr*/)
+{
+    #define GENERATE_BATCH_SIZE (64*1024)  // people generated per write, when streaming
+
+    vector<vitalStats_t> vPopulationStats;
+    runStats::phaseTimer timer(_pStats, runStats::ePhase_Generate);
+    
+    do
+    {
+        shared_ptr<argsAndErrs_t> pFB = _wpFb.lock();
+        if (pFB==nullptr || pFB.get()==nullptr)
+            break;
+        
+        long long populationSize = pFB->populationSize();
+        bool      fStream        = (pFB->generator() == argsAndErrs::eGenerator_Stream);
+        bool      fWrite         = (pCounter == nullptr) || (pFB->fused() == argsAndErrs::eFused_Tee);
+        cout << "generating "<< populationSize << " records..." << endl;
+        cout << "using seed " << pFB->seed();
+        if (pFB->shardCount())
+            cout << " on " << pFB->shardCount() << " threads, one per shard";
+        else if (fStream && pFB->threadCount() > 1)
+            cout << " on " << pFB->threadCount() << " threads";
+        cout << endl;
+
+        if (!fStream)
+        {
+            xoshiro256 rng(pFB->seed());
+            generatePeople(rng, pFB->yearRange(), vPopulationStats, populationSize);
+            cout << "generated "<< vPopulationStats.size() << " records." << endl;
+            if (pCounter)
+            {
+                for (auto &person : vPopulationStats)
+                    pCounter->addPerson(person.birthYear(), person.deathYear());
+            }
+        }
+        if (fWrite)
+            cout << "adding  "  << populationSize << " records to file '" << pFB->populationFile().c_str() << "'" << endl;
+        if (pFB->shardCount())
+        {
+            // Each shard counts into its own counter; they are merged once all shards are written
+            vector<yearCounter> counters;
+            if (pCounter)
+                counters.assign(pFB->shardCount(), yearCounter(pFB->yearRange(), pFB->countEngine(), argsAndErrs::eArgMax_Deferred));
+            if (generateShards(pFB, pCounter ? &counters : nullptr))
+                break;
+            for (auto &counter : counters)
+                pCounter->merge(counter);
+            if (_pStats)
+                _pStats->cntGenerated += populationSize;
+            break;
+        }
+        
+        bool fBinary = (pFB->format() == argsAndErrs::eFormat_Binary);
+        ofstream outStream;
+        if (fWrite)
+        {
+            outStream.open(pFB->populationFile().c_str(), fBinary ? (ios::out | ios::binary) : ios::out);
+            if (!outStream.is_open())
+            {
+                stringstream ss;
+                ss <<  "    Unable to open specified file,'" << pFB->populationFile().c_str() << "', for write." << endl;
+                pFB->addCmdLnArgsToErr(ss);
+                string strErr = ss.str();
+                pFB.get()->reportErr(strErr);
+                break;
+            }
+
+            outputBuffer out(outStream, 4*1024*1024, pFB->compress());
+            if (fBinary)
+                writeBinaryHeader(out, pFB->yearRange(), populationSize);
+            if (!fStream)
+            {
+                if (fBinary)
+                    writeBinaryRecords(out, pFB->yearRange(), vPopulationStats);
+                else
+                    writeTextRecords(out, vPopulationStats);
+            }
+        }
+        if (fStream)
+        {
+            // Each worker counts into its own counter; they are merged once all workers are done
+            vector<yearCounter> counters;
+            if (pCounter)
+                counters.assign(pFB->threadCount(), yearCounter(pFB->yearRange(), pFB->countEngine(), argsAndErrs::eArgMax_Deferred));
+
+            generateStreams(fWrite ? &outStream : nullptr, fBinary, pFB->compress(), pFB->yearRange(), pFB->seed(), pFB->threadCount(), populationSize, pCounter ? &counters : nullptr);
+            cout << "generated "<< populationSize << " records." << endl;
+
+            for (auto &counter : counters)
+                pCounter->merge(counter);
+        }
+
+        if (fWrite)
+        {
+            outStream.close();
+            cout << "added  "  << populationSize << " records to file '" << pFB->populationFile().c_str() << "'" << endl;
+        }
+        if (_pStats)
+            _pStats->cntGenerated += populationSize;
+    } while (false);
+}
+
+//--------------------------------------------------------------------------
+// Name: generateAndCountVitalStats()
+// Desc:
+//       Generate the population (see generateVitalStats()) and count the people as they are generated, in memory,
+//       rather than writing the file and reading it back (eFused_Tee still writes the file).
+//       Then report the year(s) that the maximum number of people were alive, as findMaxPopulationYear() does.
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::generateAndCountVitalStats()
+{
+    do
+    {
+        shared_ptr<argsAndErrs_t> pFB = _wpFb.lock();
+        if (pFB==nullptr || pFB.get()==nullptr)
+            break;
+
+        yearCounter counter(pFB->yearRange(), pFB->countEngine(), pFB->argMax());
+        generateVitalStats(&counter);
+
+        cout << "counted the generated records in memory" << endl;
+        runStats::phaseTimer timer(_pStats, runStats::ePhase_Reduce);
+        counter.finish();
+        timer.next(runStats::ePhase_Report);
+        reportMaxYears("file '" + pFB->populationFile() + "'", counter);
+        reportDistribution(pFB, counter);
+    } while (false);
+}
+
+//--------------------------------------------------------------------------
+// Name: generateShards()
+// Desc:
+//       Generate the population as --shards shard files (populationFile.000, ...), each generated and written on
+//       its own thread, with its own xoshiro256 stream (the seed's stream, jumped once per shard), then write
+//       populationFile as their manifest (see argsAndErrs::readManifest()).
+//       Each shard is a whole population file (a binary shard has its own header), so they can be read on their own;
+//       the same seed and shard count always generate the same shards. Once written, the shards are counted in
+//       place of the manifest (see argsAndErrs::countShards())
+// Params:
+//       pFB       - the options
+//       pCounters - one counter per shard, to count its people into; nullptr to skip counting
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool populationInfo::generateShards(shared_ptr<argsAndErrs_t> &pFB, vector<yearCounter> *pCounters)
+{
+    int                cntShards      = pFB->shardCount();
+    long long          populationSize = pFB->populationSize();
+    bool               fBinary        = (pFB->format() == argsAndErrs::eFormat_Binary);
+    const yearRange_t &range          = pFB->yearRange();
+    const string      &strManifest    = pFB->populationFile();
+
+    // Each shard is named after the manifest, numbered with at least 3 digits
+    int    cntDigits = max(3, (int)to_string(cntShards - 1).size());
+    size_t posDir    = strManifest.find_last_of("/\\");
+    vector<string>              shards(cntShards);
+    vector<long long>           cntShares(cntShards);
+    vector<unique_ptr<ofstream>> outStreams(cntShards);
+    for (int ixShard = 0; ixShard < cntShards; ixShard++)
+    {
+        string strNum     = to_string(ixShard);
+        shards[ixShard]   = strManifest + "." + string(cntDigits - strNum.size(), '0') + strNum;
+        cntShares[ixShard] = populationSize * (ixShard+1) / cntShards - populationSize * ixShard / cntShards;
+        outStreams[ixShard].reset(new ofstream(shards[ixShard].c_str(), fBinary ? (ios::out | ios::binary) : ios::out));
+        if (!outStreams[ixShard]->is_open())
+        {
+            stringstream ss;
+            ss <<  "    Unable to open shard file,'" << shards[ixShard] << "', for write." << endl;
+            reportFileErr(pFB, ss);
+            return true;
+        }
+    }
+
+    vector<thread> workers;
+    xoshiro256     rng(pFB->seed());
+    for (int ixShard = 0; ixShard < cntShards; ixShard++)
+    {
+        workers.push_back(thread([&, ixShard, rng]() mutable
+        {
+            vector<vitalStats_t> vBatch;
+            outputBuffer         out(*outStreams[ixShard], 4*1024*1024, pFB->compress());
+            if (fBinary)
+                writeBinaryHeader(out, range, cntShares[ixShard]);
+            for (long long cntRemaining = cntShares[ixShard]; cntRemaining; cntRemaining -= vBatch.size())
+            {
+                vBatch.clear();
+                generatePeople(rng, range, vBatch, min(cntRemaining, (long long)GENERATE_BATCH_SIZE));
+                if (pCounters)
+                {
+                    yearCounter &counter = (*pCounters)[ixShard];
+                    for (auto &person : vBatch)
+                        counter.addPerson(person.birthYear(), person.deathYear());
+                }
+                if (fBinary)
+                    writeBinaryRecords(out, range, vBatch);
+                else
+                    writeTextRecords(out, vBatch);
+            }
+            out.flush();
+            outStreams[ixShard]->close();
+        }));
+        rng.jump();
+    }
+    for (auto &worker : workers)
+        worker.join();
+    for (int ixShard = 0; ixShard < cntShards; ixShard++)
+    {
+        if (outStreams[ixShard]->fail())
+        {
+            stringstream ss;
+            ss <<  "    Unable to write shard file,'" << shards[ixShard] << "'." << endl;
+            reportFileErr(pFB, ss);
+            return true;
+        }
+    }
+
+    // The manifest lists each shard relative to its own directory
+    ofstream manifest(strManifest.c_str());
+    manifest << MANIFEST_MAGIC << endl;
+    for (int ixShard = 0; ixShard < cntShards; ixShard++)
+        manifest << cntShares[ixShard] << " " << shards[ixShard].substr(posDir == string::npos ? 0 : posDir+1) << endl;
+    manifest.close();
+    if (manifest.fail())
+    {
+        stringstream ss;
+        ss <<  "    Unable to write manifest file,'" << strManifest << "'." << endl;
+        reportFileErr(pFB, ss);
+        return true;
+    }
+    cout << "generated "<< populationSize << " records." << endl;
+    cout << "added  "  << populationSize << " records to " << cntShards << " shards, listed in manifest '" << strManifest << "'" << endl;
+    pFB->countShards();
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: generateStreams()
+// Desc:
+//       Generate people on worker threads, each with its own xoshiro256 stream (the seed's stream, jumped once per
+//       worker), and write them in bounded batches.
+//       Worker N generates its share of the population in batches of GENERATE_BATCH_SIZE; the batches are written
+//       in turn (batch 0 of every worker, then batch 1 of every worker, ...), so the file is the same for the
+//       same seed and thread count, while generation and formatting run in parallel.
+// Params:
+//       pOutStream     - population file, opened for write (past any header); nullptr to skip writing
+//       fBinary        - write binary records (see binaryHeader_t), rather than text
+//       codec          - compress each batch as a frame (see --compress), before it is written
+//       range          - years to generate people in
+//       seed           - seed of the first worker's stream
+//       cntThreads     - number of worker threads
+//       populationSize - number of people to generate
+//       pCounters      - one counter per worker, to count its people into; nullptr to skip counting
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::generateStreams(ofstream *pOutStream, bool fBinary, argsAndErrs::compress_t codec, const yearRange_t &range, unsigned long long seed, int cntThreads, long long populationSize,
+                                     vector<yearCounter> *pCounters)
+{
+    long long cntBatches = (populationSize / cntThreads + 1 + GENERATE_BATCH_SIZE - 1) / GENERATE_BATCH_SIZE;
+
+    mutex              mtxTurn;
+    condition_variable cvTurn;
+    long long          ixTurn = 0;  // batch ixBatch of worker ixWorker is written on turn ixBatch*cntThreads + ixWorker
+
+    vector<thread> workers;
+    xoshiro256     rng(seed);
+    for (int ixWorker = 0; ixWorker < cntThreads; ixWorker++)
+    {
+        long long cntShare = populationSize * (ixWorker+1) / cntThreads - populationSize * ixWorker / cntThreads;
+        workers.push_back(thread([&, ixWorker, cntShare, rng]() mutable
+        {
+            vector<vitalStats_t> vBatch;
+            ofstream             nullStream;
+            outputBuffer         out(pOutStream ? *pOutStream : nullStream, 0, codec); // written only on this worker's turn
+            long long            cntRemaining = cntShare;
+            for (long long ixBatch = 0; ixBatch < cntBatches; ixBatch++)
+            {
+                vBatch.clear();
+                generatePeople(rng, range, vBatch, min(cntRemaining, (long long)GENERATE_BATCH_SIZE));
+                cntRemaining -= vBatch.size();
+                if (pCounters)
+                {
+                    yearCounter &counter = (*pCounters)[ixWorker];
+                    for (auto &person : vBatch)
+                        counter.addPerson(person.birthYear(), person.deathYear());
+                }
+                if (pOutStream == nullptr)
+                    continue;
+
+                if (fBinary)
+                    writeBinaryRecords(out, range, vBatch);
+                else
+                    writeTextRecords(out, vBatch);
+
+                out.compressFrame();
+                unique_lock<mutex> lock(mtxTurn);
+                cvTurn.wait(lock, [&]() { return ixTurn == ixBatch*cntThreads + ixWorker; });
+                out.flush();
+                ixTurn++;
+                cvTurn.notify_all();
+            }
+        }));
+        rng.jump();
+    }
+    for (auto &worker : workers)
+        worker.join();
+}
+
+//--------------------------------------------------------------------------
+// Name: generatePeople()
+// Desc:
+//       Generate semi-realistic birth death years for people living in the desired time frame (range, RANGE_YEAR_BEG to RANGE_YEAR_END by default)
+//       NOTE: this will generate births before the range.yrBeg and deaths after range.yrEnd for semi-realistic life spans,
+//             then it will clip the ages to the desired time frame.
+//             This generates a relatively FLAT population curve of the range.
+//             Had we set RANGE_YEAR_MIN to RANGE_YEAR_BEG, we would get an upward ramping curve.
+//             Had we only only allowed people who died in the range to be counted, we could get a downward ramping curve.
+//             Had we only only allowed people who were born and died in the range to be counted, we could get a bell curve maximize around 1950.
+// Params:
+//       rng              - pseudo random number stream to generate from
+//       range            - years the people are clipped to
+//       vPopulationStats - the people are appended to this
+//       populationSize   - number of people to generate
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::generatePeople(xoshiro256 &rng, const yearRange_t &range, vector<vitalStats_t> &vPopulationStats, long long populationSize)
+{
+    int yrMin = range.yrBeg - MAX_AGE + 1; // RANGE_YEAR_MIN of the range
+    while (populationSize)
+    {
+        // Make some babies
+        int yrBirth  = rng.below(range.yrEnd    - yrMin)           + yrMin;
+        
+        // For whom does the bell toll?
+        int inpBias  =  rng.below(100);
+        int yrAlive  = (inpBias > 60) ? rng.below(RANGE_AGEAVG_END  - RANGE_AGEAVG_BEG)  + RANGE_AGEAVG_BEG
+                     : (inpBias > 30) ? rng.below(RANGE_AGEOUT_END  - RANGE_AGEOUT_BEG)  + RANGE_AGEOUT_BEG
+                     : (inpBias > 20) ? rng.below(RANGE_AGENEW_END  - RANGE_AGENEW_BEG)  + RANGE_AGENEW_BEG
+                     : (inpBias > 10) ? rng.below(RANGE_AGEMID_END  - RANGE_AGEMID_BEG)  + RANGE_AGEMID_BEG
+                     :                  rng.below(RANGE_AGEBAD_END  - RANGE_AGEBAD_BEG)  + RANGE_AGEBAD_BEG
+                     ;
+        int yrDeath = yrBirth + yrAlive;
+        
+        if (yrDeath > range.yrBeg)
+        {
+            // Could have used a name generation site like: http://listofrandomnames.com/, but since names are not relevant to the problem...
+            // Obfuscate/Redact 'real' names for privacy protection ;)
+            vitalStats_t person = { (uint16_t)max(range.yrBeg, yrBirth), (uint16_t)min(range.yrEnd,yrDeath) };
+            vPopulationStats.push_back(person);
+            populationSize--;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: writeTextRecords()
+// Desc:
+//        writes people, one delimited line per person (named REDACTED_FIRST_NAME REDACTED_LAST_NAME)
+// Params:
+//       out              - buffer for the file opened for write
+//       vPopulationStats - the people to write
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::writeTextRecords(outputBuffer &out, const vector<vitalStats_t> &vPopulationStats)
+{
+    string strNames = string(REDACTED_FIRST_NAME) + _delim + REDACTED_LAST_NAME + _delim; // eFileTokenFName, eFileTokenLName
+    for (auto &person : vPopulationStats)
+    {
+        out.put(strNames);
+        out.putInt(person.birthYear()); out.put(_delim); // eFileTokenBYear
+        out.putInt(person.deathYear()); out.put('\n');   // eFileTokenDYear
+        out.endRecord();
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: writeBinaryHeader()
+// Desc:
+//        writes the header of the binary format (see binaryHeader_t)
+// Params:
+//       out        - buffer for the file opened for binary write
+//       range      - years of the records
+//       cntRecords - number of records that will follow
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::writeBinaryHeader(outputBuffer &out, const yearRange_t &range, long long cntRecords)
+{
+    binaryHeader_t header(range.yrBeg, range.yrEnd, cntRecords);
+    unsigned char  head[binaryHeader_t::eSize];
+    header.write(head);
+    out.put((const char *)head, sizeof(head));
+}
+
+//--------------------------------------------------------------------------
+// Name: writeBinaryRecords()
+// Desc:
+//        writes people as fixed-width binary records (see binaryHeader_t)
+// Params:
+//       out              - buffer for the file opened for binary write, following writeBinaryHeader()
+//       range            - years of the records, as given to writeBinaryHeader()
+//       vPopulationStats - the people to write
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::writeBinaryRecords(outputBuffer &out, const yearRange_t &range, const vector<vitalStats_t> &vPopulationStats)
+{
+    binaryHeader_t header(range.yrBeg, range.yrEnd);
+    for (auto &person : vPopulationStats)
+    {
+        int ixBirth = person.birthYear() - header.yrBeg;
+        int ixDeath = person.deathYear() - header.yrBeg;
+        if (header.sizeRecord == 2)
+        {
+            out.put((char)ixBirth);
+            out.put((char)ixDeath);
+        }
+        else
+        {
+            out.put((char)ixBirth); out.put((char)(ixBirth >> 8));
+            out.put((char)ixDeath); out.put((char)(ixDeath >> 8));
+        }
+        out.endRecord();
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: deliminatedStringToTokens()
+// Desc:
+//        returns a vector of substrings that were delimited by the specified token
+// Params:
+//       inpStr - a string, delimited by _delim (in generateVitalStats())
+// Returns:
+//      vector of substrings
+//--------------------------------------------------------------------------
+vector<string> populationInfo::deliminatedStringToTokens(const string &inpStr)
+{
+    vector<string> tokens;
+
+    do
+    {
+        auto itToken=inpStr.begin();
+        for (auto itInp=itToken; itInp!=inpStr.end(); ++itInp)
+        {
+            if (*itInp == _delim)
+            {
+                tokens.push_back(string(itToken,itInp));
+                itToken = itInp+1;
+            }
+        }
+        tokens.push_back(string(itToken,inpStr.end()));
+
+    } while (false);
+
+    return tokens;
+}
+
+//--------------------------------------------------------------------------
+// Name: parseRecord()
+// Desc:
+//        decodes the years of birth & death of a single record in place, without allocating.
+//        The name fields (eFileTokenFName, eFileTokenLName) are skipped over, not copied.
+//        The years are the 3rd and 4th fields, decoded as --parser=tokens decodes them (see parseYearField()),
+//        so both parsers accept the same records: any fields after the 4th are ignored. The years must be within
+//        range, and birth may not follow death.
+// Params:
+//       pRec    - first char of the record, as written by generateVitalStats()
+//       pRecEnd - one past the last char of the record (a trailing '\r' is tolerated)
+//       range   - years that may be counted
+//       yrBirth - decoded year of birth
+//       yrDeath - decoded year of death
+// Returns:
+//      false if success; true if the record is corrupt
+//--------------------------------------------------------------------------
+bool populationInfo::parseRecord(const char *pRec, const char *pRecEnd, const yearRange_t &range, int &yrBirth, int &yrDeath) const
+{
+    const char *p = pRec;
+    for (int ixToken = eFileTokenFName; ixToken < eFileTokenBYear; ixToken++)
+    {
+        p = (const char *)memchr(p, _delim, pRecEnd-p);
+        if (p == nullptr)
+            return true;
+        p++;
+    }
+
+    const char *pBirthEnd = (const char *)memchr(p, _delim, pRecEnd-p);
+    if (pBirthEnd == nullptr || parseYearField(p, pBirthEnd, yrBirth))
+        return true;
+    p = pBirthEnd + 1;
+    const char *pDeathEnd = (const char *)memchr(p, _delim, pRecEnd-p);
+    if (parseYearField(p, pDeathEnd ? pDeathEnd : pRecEnd, yrDeath))
+        return true;
+    return (yrBirth < range.yrBeg) || (yrDeath > range.yrEnd) || (yrBirth > yrDeath);
+}
+
+//--------------------------------------------------------------------------
+// Name: parseYearField()
+// Desc:
+//        decodes a year field as stoi() does (see decodeRecord()): white space, an optional sign, then at least one digit;
+//        anything after the digits (e.g. a trailing '\r') is ignored. A value too large to be a year saturates, so it
+//        is out of range, as one stoi() can not convert is corrupt.
+// Params:
+//       p    - first char of the field
+//       pEnd - one past the last char of the field
+//       yr   - decoded year
+// Returns:
+//      false if success; true if the field has no digits
+//--------------------------------------------------------------------------
+bool populationInfo::parseYearField(const char *p, const char *pEnd, int &yr)
+{
+    #define YEAR_FIELD_MAX (100000000) // |values| this large are never years (and *10 still fits an int)
+
+    while (p < pEnd && (*p == ' ' || (unsigned)(*p - '\t') <= '\r' - '\t'))
+        p++;
+    bool fNegative = false;
+    if (p < pEnd && (*p == '+' || *p == '-'))
+        fNegative = (*p++ == '-');
+    const char *pDigits = p;
+    int         val     = 0;
+    for (; p < pEnd && (unsigned)(*p - '0') < 10; p++)
+    {
+        if (val < YEAR_FIELD_MAX)
+            val = val*10 + (*p - '0');
+    }
+    if (p == pDigits)
+        return true;
+    yr = fNegative ? -val : val;
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: describeCorruptRecord()
+// Desc:
+//        describes a record that countRecord() could not decode
+// Params:
+//       ss       - where to describe the error
+//       parser   - parser that rejected the record
+//       range    - years that may be counted
+//       pHeader  - header of a binary population file; nullptr for a text file
+//       ixRecord - 1 based index of the record in the file
+//       pRec     - first char of the record
+//       pRecEnd  - one past the last char of the record
+//       offRecord - its byte offset in the file (for a compressed file, in the decompressed bytes); -1 - not described
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::describeCorruptRecord(stringstream &ss, argsAndErrs::parser_t parser, const yearRange_t &range, const binaryHeader_t *pHeader,
+                                         long long ixRecord, const char *pRec, const char *pRecEnd, long long offRecord/*-1*/)
+{
+    vector<string> tokens = deliminatedStringToTokens(string(pRec, pRecEnd));
+    tokens.resize(max(tokens.size(), (size_t)eFileTokenDYear+1));
+
+    if (offRecord < 0)
+        ss <<  "    File corrupted at record " << ixRecord << "." << endl;
+    else
+        ss <<  "    File corrupted at record " << ixRecord << " (byte " << offRecord << ")." << endl;
+    if (pHeader)
+    {
+        if (pRecEnd - pRec < pHeader->sizeRecord)
+            ss <<  "    Expecting " << pHeader->sizeRecord << " bytes; the file ends after " << (pRecEnd - pRec) << endl;
+        else
+        {
+            const unsigned char *p = (const unsigned char *)pRec;
+            int ixBirth = (pHeader->sizeRecord == 2) ? p[0] : (p[0] | (p[1] << 8));
+            int ixDeath = (pHeader->sizeRecord == 2) ? p[1] : (p[2] | (p[3] << 8));
+            ss <<  "    Expecting years of birth (" << pHeader->yrBeg + ixBirth << ") & death (" << pHeader->yrBeg + ixDeath << ")"
+               <<  " to be in order, within " << pHeader->yrBeg << " to " << pHeader->yrEnd << endl;
+        }
+    }
+    else if (parser == argsAndErrs::eParser_Fast)
+    {
+        ss <<  "    Expecting '"<<tokens[eFileTokenBYear]<<"' to be a valid year of birth (" << range.yrBeg << " to " << range.yrEnd << ")" << endl;
+        ss <<  "    Expecting '"<<tokens[eFileTokenDYear]<<"' to be a valid year of death (" << range.yrBeg << " to " << range.yrEnd << ", not before birth)" << endl;
+    }
+    else
+    {
+        ss <<  "    Expecting '"<<tokens[eFileTokenBYear]<<"' to be a valid integer" << endl;
+        ss <<  "    Expecting '"<<tokens[eFileTokenDYear]<<"' to be a valid integer" << endl;
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: skipCorruptRecord()
+// Desc:
+//        adds a corrupt record that --on-corrupt=skip skips to the file's corruptRecords; describes it, if it is sampled
+// Params:
+//       corrupt   - the file's skipped records
+//       parser, range, pHeader, ixRecord, pRec, pRecEnd, offRecord - see describeCorruptRecord()
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::skipCorruptRecord(corruptRecords &corrupt, argsAndErrs::parser_t parser, const yearRange_t &range, const binaryHeader_t *pHeader,
+                                       long long ixRecord, const char *pRec, const char *pRecEnd, unsigned long long offRecord)
+{
+    if (corrupt.sampling())
+    {
+        stringstream ss;
+        describeCorruptRecord(ss, parser, range, pHeader, ixRecord, pRec, pRecEnd, (long long)offRecord);
+        corrupt.addSample(ss.str());
+    }
+    corrupt.add(1);
+}
+
+//--------------------------------------------------------------------------
+// Name: decodeRecord()
+// Desc:
+//        decodes a single record, with the selected parser_t
+// Params:
+//       parser   - how to decode the record
+//       range    - years that may be counted
+//       pRec     - first char of the record
+//       pRecEnd  - one past the last char of the record
+//       yrBirth  - decoded year of birth
+//       yrDeath  - decoded year of death
+// Returns:
+//      false if success; true if the record is corrupt (see describeCorruptRecord())
+//--------------------------------------------------------------------------
+inline bool populationInfo::decodeRecord(argsAndErrs::parser_t parser, const yearRange_t &range, const char *pRec, const char *pRecEnd, int &yrBirth, int &yrDeath)
+{
+    if (parser == argsAndErrs::eParser_Fast)
+        return parseRecord(pRec, pRecEnd, range, yrBirth, yrDeath);
+
+    vector<string> tokens = deliminatedStringToTokens(string(pRec, pRecEnd));
+    try
+    {
+        yrBirth = stoi(tokens.at(eFileTokenBYear));
+        yrDeath = stoi(tokens.at(eFileTokenDYear));
+    }
+    catch (...)
+    {
+        return true;
+    }
+
+    return (yrBirth < range.yrBeg) || (yrDeath > range.yrEnd) || (yrBirth > yrDeath); // would count outside the range
+}
+
+//--------------------------------------------------------------------------
+// Name: countRecords()
+// Desc:
+//        counts every newline terminated record in a block of the population file.
+//        Stops at the first corrupt record.
+//        WIDTH is counter.width(), when it has a compile-time specialized kernel (see yearBins); otherwise 0.
+// Params:
+//       parser   - how to decode each record
+//       counter  - population counts to add the people to
+//       pBlk     - first char of the block
+//       pBlkEnd  - one past the last char of the block (the last record need not be terminated)
+//       cntRecords - number of records in the block counted so far (including a corrupt one)
+//       pRecBad    - the corrupt record, if any
+//       pRecBadEnd - one past the last char of the corrupt record
+// Returns:
+//      false if success; true if a record is corrupt
+//--------------------------------------------------------------------------
+template <int WIDTH>
+bool populationInfo::countRecords(argsAndErrs::parser_t parser, yearCounter &counter, const char *pBlk, const char *pBlkEnd,
+                                  long long &cntRecords, const char *&pRecBad, const char *&pRecBadEnd)
+{
+    if (parser == argsAndErrs::eParser_Fast && recordScan::available())
+        return countIndexedRecords<WIDTH>(counter, pBlk, pBlkEnd, cntRecords, pRecBad, pRecBadEnd);
+
+    yearBins<WIDTH>    bins(counter);
+    const yearRange_t &range   = counter.range();
+    bool               fInline = counter.isArgMaxInline(); // tracks the maximum on every increment; can't use bins
+
+    bool fBad  = false;
+    cntRecords = 0;
+    for (const char *pRec = pBlk; pRec < pBlkEnd; )
+    {
+        const char *pRecEnd = (const char *)memchr(pRec, '\n', pBlkEnd-pRec);
+        if (pRecEnd == nullptr)
+            pRecEnd = pBlkEnd;
+
+        int yrBirth;
+        int yrDeath;
+        cntRecords++;
+        if (decodeRecord(parser, range, pRec, pRecEnd, yrBirth, yrDeath))
+        {
+            pRecBad    = pRec;
+            pRecBadEnd = pRecEnd;
+            fBad       = true;
+            break;
+        }
+        if (fInline)
+            counter.addPerson(yrBirth, yrDeath);
+        else
+            bins.addPerson(yrBirth - range.yrBeg, yrDeath - range.yrBeg);
+        pRec = pRecEnd+1;
+    }
+    if (!fInline)
+        bins.flush();
+    return fBad;
+}
+
+//--------------------------------------------------------------------------
+// Name: parseYear()
+// Desc:
+//        decodes a year field whose bounds countIndexedRecords() has already found
+// Params:
+//       p    - first char of the field
+//       pEnd - one past the last char of the field
+//       yr   - decoded year
+// Returns:
+//      false if success; true if the field is not 1 to 4 digits
+//--------------------------------------------------------------------------
+inline bool populationInfo::parseYear(const char *p, const char *pEnd, int &yr)
+{
+    if ((size_t)(pEnd - p - 1) >= 4)
+        return true;
+    int val = 0;
+    for (; p < pEnd; p++)
+    {
+        unsigned digit = (unsigned)(*p - '0');
+        if (digit >= 10)
+            return true;
+        val = val*10 + digit;
+    }
+    yr = val;
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: countIndexedRecords()
+// Desc:
+//        countRecords() for eParser_Fast, when recordScan::available().
+//        Rather than memchr() each record, then each of its fields, recordScan::index() finds every delimiter and
+//        newline of SCAN_BATCH_WINDOWS windows at once; each record's years are decoded from the offsets of its
+//        2nd and 3rd delimiters and its newline.
+//        A record that isn't 3 delimiters and 2 valid years is decoded again by parseRecord(), so a record is
+//        accepted, or is corrupt, exactly as it would be by the scalar parser (see describeCorruptRecord()).
+// Params:
+//       counter, pBlk, pBlkEnd, cntRecords, pRecBad, pRecBadEnd - see countRecords()
+// Returns:
+//      false if success; true if a record is corrupt
+//--------------------------------------------------------------------------
+template <int WIDTH>
+bool populationInfo::countIndexedRecords(yearCounter &counter, const char *pBlk, const char *pBlkEnd,
+                                         long long &cntRecords, const char *&pRecBad, const char *&pRecBadEnd)
+{
+    yearBins<WIDTH>    bins(counter);
+    const yearRange_t &range   = counter.range();
+    bool               fInline = counter.isArgMaxInline(); // tracks the maximum on every increment; can't use bins
+    uint64_t           mDelims[SCAN_BATCH_WINDOWS];
+    uint64_t           mNewlines[SCAN_BATCH_WINDOWS];
+    char               tail[SCAN_WINDOW_BYTES];
+
+    bool        fBad      = false;
+    const char *pRec      = pBlk;    // first char of the record being indexed
+    const char *pBirth    = nullptr; // its year of birth: one past its 2nd delimiter
+    const char *pDeath    = nullptr; // its year of death: one past its 3rd delimiter
+    int         cntDelims = 0;       // its delimiters so far
+    cntRecords = 0;
+    for (const char *pWin = pBlk; pWin < pBlkEnd && !fBad; )
+    {
+        size_t cntLeft = pBlkEnd - pWin;
+        size_t cntWins = min((size_t)SCAN_BATCH_WINDOWS, cntLeft / SCAN_WINDOW_BYTES);
+        if (cntWins == 0)
+        {
+            // Index a copy of the last, partial, window; its padding is neither delimiter nor newline
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, pWin, cntLeft);
+            recordScan::index(tail, 1, _delim, mDelims, mNewlines);
+            cntWins = 1;
+        }
+        else
+            recordScan::index(pWin, cntWins, _delim, mDelims, mNewlines);
+
+        for (size_t ixWin = 0; ixWin < cntWins && !fBad; ixWin++, pWin += SCAN_WINDOW_BYTES)
+        {
+            for (uint64_t m = mDelims[ixWin] | mNewlines[ixWin]; m; m &= m - 1)
+            {
+                const char *p = pWin + __builtin_ctzll(m);
+                if ((mNewlines[ixWin] & m & (0 - m)) == 0)
+                {
+                    cntDelims++;
+                    if (cntDelims == 2)
+                        pBirth = p + 1;
+                    else if (cntDelims == 3)
+                        pDeath = p + 1;
+                    continue;
+                }
+
+                int yrBirth;
+                int yrDeath;
+                const char *pDeathEnd = (p > pRec && p[-1] == '\r') ? p - 1 : p;
+                cntRecords++;
+                if (cntDelims != 3 || parseYear(pBirth, pDeath - 1, yrBirth) || parseYear(pDeath, pDeathEnd, yrDeath) ||
+                    yrBirth < range.yrBeg || yrDeath > range.yrEnd || yrBirth > yrDeath)
+                {
+                    // Slow path: malformed, or out of range; the scalar parser decides (and the error is described) as usual
+                    if (parseRecord(pRec, p, range, yrBirth, yrDeath))
+                    {
+                        pRecBad    = pRec;
+                        pRecBadEnd = p;
+                        fBad       = true;
+                        break;
+                    }
+                }
+                if (fInline)
+                    counter.addPerson(yrBirth, yrDeath);
+                else
+                    bins.addPerson(yrBirth - range.yrBeg, yrDeath - range.yrBeg);
+                pRec      = p + 1;
+                cntDelims = 0;
+            }
+        }
+    }
+
+    if (!fBad && pRec < pBlkEnd)
+    {
+        // The last record isn't terminated
+        int yrBirth;
+        int yrDeath;
+        cntRecords++;
+        if (parseRecord(pRec, pBlkEnd, range, yrBirth, yrDeath))
+        {
+            pRecBad    = pRec;
+            pRecBadEnd = pBlkEnd;
+            fBad       = true;
+        }
+        else if (fInline)
+            counter.addPerson(yrBirth, yrDeath);
+        else
+            bins.addPerson(yrBirth - range.yrBeg, yrDeath - range.yrBeg);
+    }
+    if (!fInline)
+        bins.flush();
+    return fBad;
+}
+
+//--------------------------------------------------------------------------
+// Name: countBinaryRecords()
+// Desc:
+//        counts every fixed-width record in a block of a binary population file.
+//        Stops at the first corrupt (or truncated) record.
+//        WIDTH is counter.width(), when it has a compile-time specialized kernel (see yearBins); otherwise 0.
+// Params:
+//       header     - header of the binary population file (its years are counter.range())
+//       counter    - population counts to add the people to
+//       pBlk       - first byte of the block (a record boundary)
+//       pBlkEnd    - one past the last byte of the block
+//       cntRecords - number of records in the block counted so far (including a corrupt one)
+//       pRecBad    - the corrupt record, if any
+//       pRecBadEnd - one past the last byte of the corrupt record
+// Returns:
+//      false if success; true if a record is corrupt
+//--------------------------------------------------------------------------
+template <int WIDTH>
+bool populationInfo::countBinaryRecords(const binaryHeader_t &header, yearCounter &counter, const char *pBlk, const char *pBlkEnd,
+                                        long long &cntRecords, const char *&pRecBad, const char *&pRecBadEnd)
+{
+    const unsigned char *pRec    = (const unsigned char *)pBlk;
+    const unsigned char *pRecEnd = (const unsigned char *)pBlkEnd;
+    int  yrBeg   = header.yrBeg;
+    int  ixEnd   = header.yrEnd - header.yrBeg;
+    bool fInline = counter.isArgMaxInline(); // tracks the maximum on every increment; can't use bins
+    yearBins<WIDTH> bins(counter);
+
+    cntRecords = 0;
+    for (; pRec + header.sizeRecord <= pRecEnd; pRec += header.sizeRecord)
+    {
+        int ixBirth = (header.sizeRecord == 2) ? pRec[0] : (pRec[0] | (pRec[1] << 8));
+        int ixDeath = (header.sizeRecord == 2) ? pRec[1] : (pRec[2] | (pRec[3] << 8));
+        cntRecords++;
+        if (ixDeath > ixEnd || ixBirth > ixDeath)
+            break;
+        if (fInline)
+            counter.addPerson(yrBeg + ixBirth, yrBeg + ixDeath);
+        else
+            bins.addPerson(ixBirth, ixDeath);
+    }
+    if (!fInline)
+        bins.flush();
+    if (pRec == pRecEnd)
+        return false;
+
+    if (pRec + header.sizeRecord > pRecEnd)
+        cntRecords++; // truncated
+    pRecBad    = (const char *)pRec;
+    pRecBadEnd = (const char *)min(pRec + header.sizeRecord, pRecEnd);
+    return true;
+}
+
+//--------------------------------------------------------------------------
+// Name: countRange()
+// Desc:
+//        counts every record in a range of the population file, text or binary,
+//        with the compile-time specialized kernel for counter.width(), if there is one
+// Params:
+//       parser     - how to decode each text record
+//       pHeader    - header of a binary population file; nullptr for a text file
+//       counter, pBeg, pEnd, cntRecords, pRecBad, pRecBadEnd - see countRecords()
+// Returns:
+//      false if success; true if a record is corrupt
+//--------------------------------------------------------------------------
+bool populationInfo::countRange(argsAndErrs::parser_t parser, const binaryHeader_t *pHeader, yearCounter &counter, const char *pBeg, const char *pEnd,
+                                long long &cntRecords, const char *&pRecBad, const char *&pRecBadEnd)
+{
+    if (counter.width() == DEFAULT_YEAR_WIDTH)
+    {
+        if (pHeader)
+            return countBinaryRecords<DEFAULT_YEAR_WIDTH>(*pHeader, counter, pBeg, pEnd, cntRecords, pRecBad, pRecBadEnd);
+        return countRecords<DEFAULT_YEAR_WIDTH>(parser, counter, pBeg, pEnd, cntRecords, pRecBad, pRecBadEnd);
+    }
+    if (pHeader)
+        return countBinaryRecords<0>(*pHeader, counter, pBeg, pEnd, cntRecords, pRecBad, pRecBadEnd);
+    return countRecords<0>(parser, counter, pBeg, pEnd, cntRecords, pRecBad, pRecBadEnd);
+}
+
+//--------------------------------------------------------------------------
+// Name: countRangeSkipping()
+// Desc:
+//        countRange(), which stops at the first corrupt record; with fSkip, it is resumed after each one until the end.
+//        The corrupt records are only noted (in bads, off the counting loops); countBlock() describes them, in file order.
+// Params:
+//       parser, pHeader, counter, pBeg, pEnd - see countRange()
+//       fSkip      - skip the corrupt records (see --on-corrupt); otherwise stop at the first
+//       cntRecords - number of records in the range counted (including the corrupt ones)
+//       cntBad     - number of corrupt records in the range
+//       bads       - the first CORRUPT_SAMPLES of them (just the first, without fSkip)
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::countRangeSkipping(argsAndErrs::parser_t parser, const binaryHeader_t *pHeader, yearCounter &counter, const char *pBeg, const char *pEnd,
+                                        bool fSkip, long long &cntRecords, long long &cntBad, vector<badRecord_t> &bads)
+{
+    cntRecords = 0;
+    cntBad     = 0;
+    while (pBeg < pEnd)
+    {
+        long long   cnt;
+        const char *pRecBad    = nullptr;
+        const char *pRecBadEnd = nullptr;
+        bool        fBad       = countRange(parser, pHeader, counter, pBeg, pEnd, cnt, pRecBad, pRecBadEnd);
+        cntRecords += cnt;
+        if (!fBad)
+            break;
+
+        cntBad++;
+        if (bads.size() < CORRUPT_SAMPLES)
+            bads.push_back(badRecord_t{ cntRecords, pRecBad, pRecBadEnd });
+        if (!fSkip)
+            break;
+        // Resume after the corrupt record (a truncated binary record, or an unterminated line, ends the range)
+        if (pHeader)
+            pBeg = (pEnd - pRecBad > pHeader->sizeRecord) ? pRecBad + pHeader->sizeRecord : pEnd;
+        else
+            pBeg = (pRecBadEnd < pEnd) ? pRecBadEnd + 1 : pEnd;
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: countBlock()
+// Desc:
+//        counts every record in a block of the population file.
+//        Without a pool, the block is split into record aligned byte ranges, one per worker thread.
+//        With a pool (see findMaxPopulationYear() and countFiles()), it is split into many small POOL_CHUNK_BYTES
+//        chunks queued on the pool: a thread that is done with its chunks steals the others', so a slow region
+//        (corrupt or long lines, a slower device) or a file much larger than the others is still spread over every thread.
+//        Each range (or pool thread) counts into its own yearCounter; they are merged once all of them are done.
+//        With pCorrupt (--on-corrupt=skip), corrupt records are skipped: each range notes its own, and they are
+//        added to pCorrupt in file order, so the samples are the file's first corrupt records.
+// Params:
+//       pFB        - the options (parser, engine, threads)
+//       pPool      - pool to count the chunks on; nullptr to start a thread per range
+//       pHeader    - header of a binary population file; nullptr for a text file
+//       counter    - population counts to add the people to
+//       pBlk       - first char of the block
+//       pBlkEnd    - one past the last char of the block
+//       offBlk     - byte offset of the block in the file
+//       ixRecord   - 1 based index of the last record counted; updated for each record in the block
+//       pCorrupt   - the skipped corrupt records; nullptr to stop at the first
+//       ssErr      - the error, if a record is corrupt
+// Returns:
+//      false if success; true if a record is corrupt (and pCorrupt is nullptr)
+//--------------------------------------------------------------------------
+bool populationInfo::countBlock(shared_ptr<argsAndErrs_t> &pFB, workPool *pPool, const binaryHeader_t *pHeader, yearCounter &counter,
+                                const char *pBlk, const char *pBlkEnd, unsigned long long offBlk, long long &ixRecord, corruptRecords *pCorrupt, stringstream &ssErr)
+{
+    #define MIN_BYTES_PER_THREAD (64*1024)    // not worth a thread below this
+    #define POOL_CHUNK_BYTES     (256*1024)   // bytes per pool task
+
+    argsAndErrs::parser_t parser = pFB->parser();
+    size_t cntBytes  = pBlkEnd - pBlk;
+    size_t cntRanges = pPool ? (cntBytes + POOL_CHUNK_BYTES - 1) / POOL_CHUNK_BYTES
+                             : min((size_t)pFB->threadCount(), max((size_t)1, cntBytes / MIN_BYTES_PER_THREAD));
+    cntRanges = max((size_t)1, cntRanges);
+
+    // The records and corrupt records are kept per range, so each corrupt record's index in the file is known
+    vector<long long>           cntRecs(cntRanges, 0);
+    vector<long long>           cntBads(cntRanges, 0);
+    vector<vector<badRecord_t>> bads(cntRanges);
+    bool                        fSkip = (pCorrupt != nullptr);
+    size_t                      cntCounters = 0;
+    vector<yearCounter>         counters;
+    vector<char>                fUsed;
+    if (cntRanges == 1)
+        countRangeSkipping(parser, pHeader, counter, pBlk, pBlkEnd, fSkip, cntRecs[0], cntBads[0], bads[0]);
+    else
+    {
+        // Split into record aligned ranges
+        vector<const char *> ranges(cntRanges+1, pBlkEnd);
+        ranges[0] = pBlk;
+        for (size_t ixRange = 1; ixRange < cntRanges; ixRange++)
+        {
+            const char *pSplit = max(ranges[ixRange-1], pBlk + cntBytes * ixRange / cntRanges);
+            if (pHeader)
+            {
+                ranges[ixRange] = pSplit - (pSplit - pBlk) % pHeader->sizeRecord;
+                continue;
+            }
+            const char *pNl    = (const char *)memchr(pSplit, '\n', pBlkEnd-pSplit);
+            ranges[ixRange]    = pNl ? pNl+1 : pBlkEnd;
+        }
+
+        // Each range (on a pool, each thread) has a private counter; the per-year argmax is always deferred to the merged counts
+        cntCounters = pPool ? pPool->threadCount() : cntRanges;
+        counters.assign(cntCounters, yearCounter(counter.range(), pFB->countEngine(), argsAndErrs::eArgMax_Deferred));
+        fUsed.assign(cntCounters, false);
+        auto countOne = [&](size_t ixRange, size_t ixCounter)
+        {
+            fUsed[ixCounter] = true;
+            countRangeSkipping(parser, pHeader, counters[ixCounter], ranges[ixRange], ranges[ixRange+1],
+                               fSkip, cntRecs[ixRange], cntBads[ixRange], bads[ixRange]);
+        };
+        if (pPool)
+        {
+            workPool::taskGroup group;
+            for (size_t ixRange = 0; ixRange < cntRanges; ixRange++)
+                pPool->submit([&countOne, pPool, ixRange]() { countOne(ixRange, pPool->selfQueue()); }, group);
+            pPool->wait(group);
+        }
+        else
+        {
+            vector<thread> workers;
+            for (size_t ixRange = 0; ixRange < cntRanges; ixRange++)
+                workers.push_back(thread(countOne, ixRange, ixRange));
+            for (auto &worker : workers)
+                worker.join();
+        }
+    }
+
+    // Merge, in file order, so each corrupt record is reported with its index in the file
+    for (size_t ixRange = 0; ixRange < cntRanges; ixRange++)
+    {
+        long long ixRecordRange = ixRecord;
+        ixRecord += cntRecs[ixRange];
+        for (auto &bad : bads[ixRange])
+        {
+            if (!fSkip)
+            {
+                describeCorruptRecord(ssErr, parser, counter.range(), pHeader, ixRecordRange + bad.ixRecord, bad.pRec, bad.pRecEnd);
+                return true;
+            }
+            skipCorruptRecord(*pCorrupt, parser, counter.range(), pHeader, ixRecordRange + bad.ixRecord, bad.pRec, bad.pRecEnd, offBlk + (bad.pRec - pBlk));
+        }
+        if (fSkip)
+            pCorrupt->add(cntBads[ixRange] - (long long)bads[ixRange].size());
+    }
+    for (size_t ixCounter = 0; ixCounter < cntCounters; ixCounter++)
+        if (fUsed[ixCounter])
+            counter.merge(counters[ixCounter]);
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: findMaxPopulationYear()
+// Desc:
+//        Process the file and report the year that the maximum number of people were alive.
+//        If the maximum occurs in multile years, all years will be reported.
+//        Several files (see argsAndErrs::populationFiles()) are counted by countFiles().
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::findMaxPopulationYear()
+{
+    bool fDoBreak = false;
+    do
+    {
+        shared_ptr<argsAndErrs_t> pFB = _wpFb.lock();
+        if (pFB==nullptr || pFB.get()==nullptr)
+            break;
+
+        if (pFB->populationFiles().size() > 1)
+        {
+            countFiles(pFB);
+            break;
+        }
+        
+        yearCounter counter(pFB->yearRange(), pFB->countEngine(), pFB->argMax());
+
+        if (pFB->fromStdin())
+            cout << "reading records from stdin" << endl;
+        else
+            cout << "reading records from file '" << pFB->populationFile().c_str() << "'" << endl;
+
+        long long      ixRecord=0;
+        stringstream   ssErr;
+        corruptRecords corrupt;
+        corruptRecords *pCorrupt = (pFB->onCorrupt() == argsAndErrs::eOnCorrupt_Skip) ? &corrupt : nullptr;
+        // --reader=stream parses each line into the store, which is then counted (the store is never resumed, and
+        // stdin can't seek back past the header peek: both need the block readers)
+        bool fStream = (pFB->reader() == argsAndErrs::eReader_Stream) && !pFB->fromStdin() && pFB->checkpointFileFor(pFB->populationFile()).empty();
+        if (fStream || pFB->store())
+        {
+            populationStore store;
+            if (( fDoBreak = loadStore(pFB, pFB->populationFile(), store, ixRecord, pCorrupt, ssErr) ))
+            {
+                reportFileErr(pFB, ssErr);
+                break;
+            }
+            cout << "loaded " << store.size() << " records into memory" << endl;
+            if (store.hasNames())
+                cout << "kept their names: " << store.names().bytes() << " bytes of names"
+                     << (store.names().interned() ? ", " + to_string(store.names().distinct()) + " distinct" : string()) << endl;
+
+            runStats::phaseTimer timer(_pStats, runStats::ePhase_Count);
+            counter = yearCounter(store.range(), pFB->countEngine(), pFB->argMax());
+            store.countInto(counter);
+        }
+        else if (pFB->threadCount() > 1)
+        {
+            // Each block is split into small chunks that the threads take as they go (see countBlock())
+            workPool pool(pFB->threadCount());
+            fDoBreak = countFile(pFB, &pool, pFB->populationFile(), counter, ixRecord, pCorrupt, cout, ssErr);
+        }
+        else
+            fDoBreak = countFile(pFB, nullptr, pFB->populationFile(), counter, ixRecord, pCorrupt, cout, ssErr);
+        if (fDoBreak)
+        {
+            reportFileErr(pFB, ssErr);
+            break;
+        }
+        corrupt.report(cout, ixRecord);
+
+        runStats::phaseTimer timer(_pStats, runStats::ePhase_Reduce);
+        counter.finish();
+        timer.next(runStats::ePhase_Report);
+        reportMaxYears("file '" + pFB->populationFile() + "'", counter);
+        reportDistribution(pFB, counter);
+    } while (false);
+}
+
+//--------------------------------------------------------------------------
+// Name: openPopulation()
+// Desc:
+//        opens a population file with a block reader (mmap or buffered, see --reader), and detects the binary format
+//        by its magic: a binary file's own years are used, unless --years= asks for others (an error)
+// Params:
+//       pFB      - the options
+//       pPool    - pool to decompress a compressed file's frames on (see compressedReader); nullptr to start threads
+//       strFile  - the population file
+//       sizeRead - bytes per block
+//       pReader  - the opened reader; its framing is left to the caller (see populationReader::setFraming())
+//       header   - header of a binary population file
+//       pHeader  - &header, for a binary population file; nullptr for a text file
+//       ssErr    - the error, if the file can not be counted
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool populationInfo::openPopulation(shared_ptr<argsAndErrs_t> &pFB, workPool *pPool, const string &strFile, size_t sizeRead, unique_ptr<populationReader> &pReader,
+                                    binaryHeader_t &header, binaryHeader_t *&pHeader, stringstream &ssErr)
+{
+    if (pFB->reader() == argsAndErrs::eReader_Mmap)
+        pReader.reset(new mmapReader(sizeRead));
+    else if (pFB->reader() == argsAndErrs::eReader_Async)
+        pReader.reset(new asyncReader(sizeRead));
+    else
+        pReader.reset(new bufferedReader(sizeRead));
+    if (pReader->open(strFile))
+    {
+        describeUnreadableFile(ssErr, strFile);
+        return true;
+    }
+
+    // Auto-detect compression, then the binary format, by their magic
+    pHeader = nullptr;
+    char   head[binaryHeader_t::eSize];
+    size_t cntHead = pReader->peek(head, sizeof(head));
+    argsAndErrs::compress_t codec = frameCodec::detect(head, cntHead);
+    if (codec != argsAndErrs::eCompress_None)
+    {
+        if (strFile == STDIN_FILE_NAME || !frameCodec::supported(codec))
+        {
+            ssErr <<  "    Population file,'" << strFile << "', is " << frameCodec::name(codec) << " compressed." << endl;
+            if (strFile == STDIN_FILE_NAME)
+                ssErr <<  "    A compressed stdin is not decompressed; decompress it into the pipe (e.g. zcat, zstdcat)." << endl;
+            else
+                ssErr <<  "    This build can not decompress it; rebuild with "
+                      << ((codec == argsAndErrs::eCompress_Gzip) ? "-DSGI_WITH_ZLIB=1 -lz" : "-DSGI_WITH_ZSTD=1 -lzstd") << "." << endl;
+            return true;
+        }
+        // The frames are decompressed on the pool, or (without one) by the threads the file has to itself (see countFile())
+        int cntThreads = max(1, pFB->threadCount() / (int)max((size_t)1, pFB->populationFiles().size()));
+        pReader.reset(new compressedReader(codec, pPool, cntThreads, sizeRead));
+        if (pReader->open(strFile))
+        {
+            describeUnreadableFile(ssErr, strFile);
+            return true;
+        }
+        cntHead = pReader->peek(head, sizeof(head));
+    }
+    if (!binaryHeader_t::isBinary(head, cntHead))
+        return false;
+    if (header.read((const unsigned char *)head, cntHead))
+    {
+        describeBadBinaryFile(ssErr, strFile, "Unsupported version, or corrupted header.");
+        return true;
+    }
+    // The file's own years are counted, unless --years= asks for others
+    yearRange_t rangeFile(header.yrBeg, header.yrEnd);
+    if (pFB->yearRangeSet() && rangeFile != pFB->yearRange())
+    {
+        stringstream ss;
+        ss << "Its years (" << header.yrBeg << " to " << header.yrEnd << ") differ from --years=" << pFB->yearRange().yrBeg << "-" << pFB->yearRange().yrEnd << ".";
+        describeBadBinaryFile(ssErr, strFile, ss.str());
+        return true;
+    }
+    pHeader = &header;
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: loadStore()
+// Desc:
+//        loads every record of a population file, text or binary, into a populationStore, so it can be counted (or
+//        queried) without parsing the file again. --reader=stream getline()s a text file; otherwise the file is read
+//        in blocks (see openPopulation()).
+// Params:
+//       pFB      - the options
+//       strFile  - the population file
+//       store    - the population; it takes the file's years (see openPopulation())
+//       ixRecord - number of records loaded (including the corrupt ones)
+//       pCorrupt - the corrupt records skipped (see --on-corrupt); nullptr to stop at the first
+//       ssErr    - the error, if the file can not be loaded
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool populationInfo::loadStore(shared_ptr<argsAndErrs_t> &pFB, const string &strFile, populationStore &store, long long &ixRecord,
+                               corruptRecords *pCorrupt, stringstream &ssErr)
+{
+    #define STORE_READ_BYTES (4*1024*1024)  // bytes per block read into the store
+
+    bool fDoBreak = false;
+    do
+    {
+        runStats::phaseTimer timer(_pStats, runStats::ePhase_Open);
+        store = populationStore(pFB->yearRange(), pFB->names());
+        if (pFB->reader() == argsAndErrs::eReader_Stream && strFile != STDIN_FILE_NAME)
+        {
+            ifstream inpStream;
+            inpStream.open(strFile.c_str(), ios::in | ios::binary);
+            if (( fDoBreak = !inpStream.is_open() ))
+            {
+                describeUnreadableFile(ssErr, strFile);
+                break;
+            }
+
+            // getline() has no meaning for binary records (or compressed bytes); they are read in blocks below
+            char head[binaryHeader_t::eSize];
+            inpStream.read(head, sizeof(head));
+            bool fBinary = binaryHeader_t::isBinary(head, (size_t)inpStream.gcount()) ||
+                           frameCodec::detect(head, (size_t)inpStream.gcount()) != argsAndErrs::eCompress_None;
+            inpStream.clear();
+            inpStream.seekg(0);
+
+            timer.next(runStats::ePhase_Read);
+            string             strDelimitedLine;
+            unsigned long long offRec = 0; // byte offset of the line
+            while (!fBinary && getline(inpStream, strDelimitedLine))
+            {
+                const char *pRec    = strDelimitedLine.data();
+                const char *pRecEnd = pRec + strDelimitedLine.size();
+                int yrBirth;
+                int yrDeath;
+                ixRecord++;
+                offRec += strDelimitedLine.size() + 1;
+                if (decodeRecord(pFB->parser(), store.range(), pRec, pRecEnd, yrBirth, yrDeath))
+                {
+                    if (pCorrupt)
+                    {
+                        skipCorruptRecord(*pCorrupt, pFB->parser(), store.range(), nullptr, ixRecord, pRec, pRecEnd, offRec - strDelimitedLine.size() - 1);
+                        continue;
+                    }
+                    describeCorruptRecord(ssErr, pFB->parser(), store.range(), nullptr, ixRecord, pRec, pRecEnd);
+                    fDoBreak = true;
+                    break;
+                }
+                if (store.hasNames())
+                    storeNamedPerson(store, yrBirth, yrDeath, pRec, pRecEnd);
+                else
+                    store.addPerson(yrBirth, yrDeath);
+            } // while() there are more people to read in
+            if (fBinary)
+                timer.next(runStats::ePhase_Open);
+            else
+            {
+                if (_pStats)
+                {
+                    _pStats->cntFiles++;
+                    _pStats->cntRecords += ixRecord;
+                    _pStats->cntCorrupt += fDoBreak ? 1 : (pCorrupt ? pCorrupt->count() : 0);
+                    if (!fDoBreak)
+                        _pStats->cntBytes += fileSize(strFile);
+                }
+                break;
+            }
+        }
+
+        unique_ptr<populationReader> pReader;
+        binaryHeader_t               header;
+        binaryHeader_t              *pHeader = nullptr;
+        if (( fDoBreak = openPopulation(pFB, nullptr, strFile, STORE_READ_BYTES, pReader, header, pHeader, ssErr) ))
+            break;
+        if (pHeader)
+            store = populationStore(yearRange_t(header.yrBeg, header.yrEnd), pFB->names());
+        pReader->setFraming(pHeader ? binaryHeader_t::eSize : 0, pHeader ? header.sizeRecord : 0);
+        if (_pStats)
+            _pStats->cntFiles++;
+
+        const char *pBlk;
+        const char *pBlkEnd;
+        timer.next(runStats::ePhase_Read);
+        while (pReader->nextBlock(pBlk, pBlkEnd))
+        {
+            long long ixRecordBlk = ixRecord;
+            long long cntCorrupt  = pCorrupt ? pCorrupt->count() : 0;
+            fDoBreak = storeRecords(pFB->parser(), pHeader, store, pBlk, pBlkEnd, pReader->offset() - (pBlkEnd - pBlk), ixRecord, pCorrupt, ssErr);
+            if (_pStats)
+            {
+                _pStats->cntBytes   += pBlkEnd - pBlk;
+                _pStats->cntRecords += ixRecord - ixRecordBlk;
+                _pStats->cntCorrupt += fDoBreak ? 1 : (pCorrupt ? pCorrupt->count() - cntCorrupt : 0);
+            }
+            if (fDoBreak)
+                break;
+        } // while() there are more blocks of people to read in
+        if (fDoBreak)
+            break;
+        if (( fDoBreak = pReader->failed() ))
+        {
+            describeUnreadableData(ssErr, strFile, ixRecord, pReader->whyFailed());
+            break;
+        }
+
+        if (( fDoBreak = pHeader && (unsigned long long)ixRecord != header.cntRecords ))
+        {
+            stringstream ss;
+            ss << "Its header lists " << header.cntRecords << " records, but " << ixRecord << " were read.";
+            describeBadBinaryFile(ssErr, strFile, ss.str());
+            break;
+        }
+    } while (false);
+
+    return fDoBreak;
+}
+
+//--------------------------------------------------------------------------
+// Name: storeNamedPerson()
+// Desc:
+//        add the person of a decoded text record to the store, with the record's names (eFileTokenFName, eFileTokenLName)
+// Params:
+//       store    - the population to add the person to (it keeps the names)
+//       yrBirth  - decoded year of birth
+//       yrDeath  - decoded year of death
+//       pRec     - first char of the record
+//       pRecEnd  - one past the last char of the record
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::storeNamedPerson(populationStore &store, int yrBirth, int yrDeath, const char *pRec, const char *pRecEnd)
+{
+    const char *pFirstEnd = (const char *)memchr(pRec, _delim, pRecEnd-pRec);
+    const char *pLast     = pFirstEnd ? pFirstEnd+1 : pRecEnd;
+    const char *pLastEnd  = (const char *)memchr(pLast, _delim, pRecEnd-pLast);
+    if (pFirstEnd == nullptr)
+        pFirstEnd = pRecEnd;
+    if (pLastEnd == nullptr)
+        pLastEnd = pRecEnd;
+    store.addPerson(yrBirth, yrDeath, pRec, pFirstEnd-pRec, pLast, pLastEnd-pLast);
+}
+
+//--------------------------------------------------------------------------
+// Name: storeRecords()
+// Desc:
+//        decodes every record in a block of the population file into the store.
+//        Stops at the first corrupt record, unless pCorrupt skips them.
+// Params:
+//       parser   - how to decode each text record
+//       pHeader  - header of a binary population file (its years are store.range()); nullptr for a text file
+//       store    - the population to add the people to
+//       pBlk     - first char of the block (a record boundary)
+//       pBlkEnd  - one past the last char of the block (the last text record need not be terminated)
+//       offBlk   - byte offset of the block in the file
+//       ixRecord - 1 based index of the last record loaded; updated for each record in the block
+//       pCorrupt - the corrupt records skipped (see --on-corrupt); nullptr to stop at the first
+//       ssErr    - the error, if a record is corrupt
+// Returns:
+//      false if success; true if a record is corrupt (and pCorrupt is nullptr)
+//--------------------------------------------------------------------------
+bool populationInfo::storeRecords(argsAndErrs::parser_t parser, const binaryHeader_t *pHeader, populationStore &store, const char *pBlk, const char *pBlkEnd,
+                                  unsigned long long offBlk, long long &ixRecord, corruptRecords *pCorrupt, stringstream &ssErr)
+{
+    const yearRange_t &range = store.range();
+    if (pHeader)
+    {
+        const unsigned char *pRec    = (const unsigned char *)pBlk;
+        const unsigned char *pRecEnd = (const unsigned char *)pBlkEnd;
+        int sizeRecord = pHeader->sizeRecord;
+        int ixEnd      = range.yrEnd - range.yrBeg;
+        for (;;)
+        {
+            for (; pRec + sizeRecord <= pRecEnd; pRec += sizeRecord)
+            {
+                int ixBirth = (sizeRecord == 2) ? pRec[0] : (pRec[0] | (pRec[1] << 8));
+                int ixDeath = (sizeRecord == 2) ? pRec[1] : (pRec[2] | (pRec[3] << 8));
+                ixRecord++;
+                if (ixDeath > ixEnd || ixBirth > ixDeath)
+                    break;
+                store.addPerson(range.yrBeg + ixBirth, range.yrBeg + ixDeath);
+            }
+            if (pRec == pRecEnd)
+                return false;
+
+            if (pRec + sizeRecord > pRecEnd)
+                ixRecord++; // truncated
+            const char *pBad    = (const char *)pRec;
+            const char *pBadEnd = (const char *)min(pRec + sizeRecord, pRecEnd);
+            if (pCorrupt == nullptr)
+            {
+                describeCorruptRecord(ssErr, parser, range, pHeader, ixRecord, pBad, pBadEnd);
+                return true;
+            }
+            skipCorruptRecord(*pCorrupt, parser, range, pHeader, ixRecord, pBad, pBadEnd, offBlk + (pBad - pBlk));
+            if (pBadEnd == pBlkEnd)
+                return false;
+            pRec += sizeRecord;
+        }
+    }
+
+    bool fNames = store.hasNames();
+    for (const char *pRec = pBlk; pRec < pBlkEnd; )
+    {
+        const char *pRecEnd = (const char *)memchr(pRec, '\n', pBlkEnd-pRec);
+        if (pRecEnd == nullptr)
+            pRecEnd = pBlkEnd;
+
+        int yrBirth;
+        int yrDeath;
+        ixRecord++;
+        if (decodeRecord(parser, range, pRec, pRecEnd, yrBirth, yrDeath))
+        {
+            if (pCorrupt == nullptr)
+            {
+                describeCorruptRecord(ssErr, parser, range, nullptr, ixRecord, pRec, pRecEnd);
+                return true;
+            }
+            skipCorruptRecord(*pCorrupt, parser, range, nullptr, ixRecord, pRec, pRecEnd, offBlk + (pRec - pBlk));
+        }
+        else if (fNames)
+            storeNamedPerson(store, yrBirth, yrDeath, pRec, pRecEnd);
+        else
+            store.addPerson(yrBirth, yrDeath);
+        pRec = pRecEnd+1;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: countFile()
+// Desc:
+//        counts every record of a population file with the block readers (mmap or buffered, see --reader):
+//        detects the binary format, resumes from (and saves) its checkpoint (see --checkpoint), and counts each block
+// Params:
+//       pFB      - the options
+//       pPool    - pool to count the blocks' chunks on (see countBlock()); nullptr to start threads for each block
+//       strFile  - the population file
+//       counter  - population counts to add the people to; replaced by one with the file's years, for a binary file
+//       ixRecord - number of records counted
+//       pCorrupt - the corrupt records skipped (see countBlock()); nullptr to stop at the first
+//       log      - where to report progress (the checkpoint)
+//       ssErr    - the error, if the file can not be counted
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool populationInfo::countFile(shared_ptr<argsAndErrs_t> &pFB, workPool *pPool, const string &strFile, yearCounter &counter,
+                               long long &ixRecord, corruptRecords *pCorrupt, ostream &log, stringstream &ssErr)
+{
+    bool fDoBreak = false;
+    do
+    {
+        // The mapped (or large buffered) bytes are parsed in place, without copying each line.
+        // Each block is 4MB per thread, split between the files read at once: 4MB * (threads / files), and at least 4MB
+        size_t cntShare = max((size_t)1, (size_t)pFB->threadCount() / max((size_t)1, pFB->populationFiles().size()));
+        size_t sizeRead = (size_t)4*1024*1024 * cntShare;
+        runStats::phaseTimer timer(_pStats, runStats::ePhase_Open);
+        unique_ptr<populationReader> pReader;
+        binaryHeader_t               header;
+        binaryHeader_t              *pHeader = nullptr;
+        if (( fDoBreak = openPopulation(pFB, pPool, strFile, sizeRead, pReader, header, pHeader, ssErr) ))
+            break;
+        // The file's own years are counted
+        if (pHeader)
+            counter = yearCounter(yearRange_t(header.yrBeg, header.yrEnd), pFB->countEngine(), pFB->argMax());
+
+        // Records already counted by the last run are skipped, along with any header
+        size_t             offRecords = pHeader ? binaryHeader_t::eSize : 0;
+        size_t             sizeRecord = pHeader ? header.sizeRecord : 0;
+        unsigned long long offResume  = offRecords;
+        prefixHash         hash;
+        string             strCkpt    = pFB->checkpointFileFor(strFile);
+        if (strCkpt.size() && !pReader->resumable())
+        {
+            log << "checkpoint not used; a compressed file is always counted whole" << endl;
+            strCkpt.clear();
+        }
+        if (strCkpt.size())
+            loadCheckpoint(strFile, strCkpt, counter, offRecords, sizeRecord, offResume, ixRecord,
+                           pFB->checkpointVerify() == argsAndErrs::eCheckpointVerify_Full, hash, log);
+        pReader->setFraming(offResume, sizeRecord);
+        if (_pStats)
+            _pStats->cntFiles++;
+
+        // With mmap, the file is read (paged in) while it is counted
+        const char *pBlk;
+        const char *pBlkEnd;
+        char        chLast = '\n';  // last byte counted; a text checkpoint must end on a whole record
+        timer.next(runStats::ePhase_Read);
+        while (pReader->nextBlock(pBlk, pBlkEnd))
+        {
+            timer.next(runStats::ePhase_Count);
+            long long ixRecordBlk = ixRecord;
+            long long cntCorrupt  = pCorrupt ? pCorrupt->count() : 0;
+            if (strCkpt.size())
+                hash.add(pBlk, pBlkEnd); // the checkpoint covers every byte counted
+            fDoBreak = countBlock(pFB, pPool, pHeader, counter, pBlk, pBlkEnd, pReader->offset() - (pBlkEnd - pBlk), ixRecord, pCorrupt, ssErr);
+            if (_pStats)
+            {
+                _pStats->cntBytes   += pBlkEnd - pBlk;
+                _pStats->cntRecords += ixRecord - ixRecordBlk;
+                _pStats->cntCorrupt += fDoBreak ? 1 : (pCorrupt ? pCorrupt->count() - cntCorrupt : 0);
+            }
+            if (fDoBreak)
+                break;
+            if (pBlkEnd > pBlk)
+                chLast = pBlkEnd[-1];
+            timer.next(runStats::ePhase_Read);
+        } // while() there are more blocks of people to read in
+        timer.stop();
+        if (fDoBreak)
+            break;
+        if (( fDoBreak = pReader->failed() ))
+        {
+            describeUnreadableData(ssErr, strFile, ixRecord, pReader->whyFailed());
+            break;
+        }
+
+        if (( fDoBreak = pHeader && (unsigned long long)ixRecord != header.cntRecords ))
+        {
+            stringstream ss;
+            ss << "Its header lists " << header.cntRecords << " records, but " << ixRecord << " were read.";
+            describeBadBinaryFile(ssErr, strFile, ss.str());
+            break;
+        }
+
+        unsigned long long offEnd = max(offResume, pReader->offset());
+        if (strCkpt.size() && offEnd != offResume)
+        {
+            if (pHeader || chLast == '\n')
+                saveCheckpoint(strFile, strCkpt, counter, offRecords, offEnd, ixRecord, hash, log);
+            else
+                log << "checkpoint not saved; the last record is not newline terminated (yet)" << endl;
+        }
+    } while (false);
+
+    return fDoBreak;
+}
+
+//--------------------------------------------------------------------------
+// Name: countFiles()
+// Desc:
+//        Process every population file (see argsAndErrs::populationFiles()) on a shared work-stealing pool,
+//        and report the year(s) that the maximum number of people were alive in each file, then in all of them.
+//        Each file is a task, and each block of a file is split into chunk tasks (see countBlock()),
+//        so the threads that are done with the small files help count the large ones.
+//        A file that can not be counted is reported, and left out of the combined result;
+//        so is a binary file whose years differ from the others (see --years).
+// Params:
+//       pFB - the population files and options
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::countFiles(shared_ptr<argsAndErrs_t> &pFB)
+{
+    const vector<string> &files    = pFB->populationFiles();
+    size_t                cntFiles = files.size();
+    cout << "reading records from " << cntFiles << " files on " << pFB->threadCount() << " threads" << endl;
+
+    // Each file counts into its own counter; the progress and errors of each are reported in file order, afterwards
+    vector<yearCounter> counters(cntFiles, yearCounter(pFB->yearRange(), pFB->countEngine(), argsAndErrs::eArgMax_Deferred));
+    vector<long long>   cntRecords(cntFiles, 0);
+    vector<char>        fErrs(cntFiles, false);
+    vector<string>      strLogs(cntFiles);
+    {
+        workPool            pool(pFB->threadCount());
+        workPool::taskGroup group;
+        for (size_t ixFile = 0; ixFile < cntFiles; ixFile++)
+        {
+            pool.submit([&, ixFile]()
+            {
+                stringstream   log;
+                stringstream   ssErr;
+                corruptRecords corrupt;
+                fErrs[ixFile]   = countFile(pFB, &pool, files[ixFile], counters[ixFile], cntRecords[ixFile],
+                                            (pFB->onCorrupt() == argsAndErrs::eOnCorrupt_Skip) ? &corrupt : nullptr, log, ssErr);
+                if (!fErrs[ixFile])
+                    corrupt.report(log, cntRecords[ixFile]);
+                strLogs[ixFile] = log.str() + ssErr.str();
+            }, group);
+        }
+        pool.wait(group);
+    }
+
+    runStats::phaseTimer timer(_pStats, runStats::ePhase_Reduce);
+    yearCounter total(pFB->yearRange(), pFB->countEngine(), argsAndErrs::eArgMax_Deferred);
+    long long   cntTotal  = 0;
+    size_t      cntMerged = 0;
+    for (size_t ixFile = 0; ixFile < cntFiles; ixFile++)
+    {
+        cout << endl << "file '" << files[ixFile] << "'";
+        if (fErrs[ixFile])
+        {
+            cout << " can not be processed:" << endl << strLogs[ixFile];
+            continue;
+        }
+        cout << " (" << cntRecords[ixFile] << " records):" << endl << strLogs[ixFile];
+        if (counters[ixFile].range() != total.range())
+            cout << "Its years (" << counters[ixFile].range().yrBeg << " to " << counters[ixFile].range().yrEnd << ") differ; it is left out of the combined result." << endl;
+        else
+        {
+            total.merge(counters[ixFile]);
+            cntTotal += cntRecords[ixFile];
+            cntMerged++;
+        }
+        counters[ixFile].finish();
+        timer.next(runStats::ePhase_Report);
+        reportMaxYears("file '" + files[ixFile] + "'", counters[ixFile]);
+        timer.next(runStats::ePhase_Reduce);
+    }
+
+    cout << endl << "all " << cntMerged << " of " << cntFiles << " files (" << cntTotal << " records):" << endl;
+    total.finish();
+    timer.next(runStats::ePhase_Report);
+    reportMaxYears("any of the files", total);
+    reportDistribution(pFB, total);
+}
+
+//--------------------------------------------------------------------------
+// Name: serveQueries()
+// Desc:
+//        Load populationFile into memory (see loadStore()) and count it once, as findMaxPopulationYear() does, then
+//        index the population of each year (see yearIndex) and answer queries (see answerQuery()), one per line on
+//        stdin, with one line each on stdout, until 'quit' or the end of the input. The first line out is 'ok ready <records> <BEG-END>', once the population is loaded.
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::serveQueries()
+{
+    do
+    {
+        shared_ptr<argsAndErrs_t> pFB = _wpFb.lock();
+        if (pFB==nullptr || pFB.get()==nullptr)
+            break;
+
+        populationStore store;
+        long long       ixRecord = 0;
+        stringstream    ssErr;
+        corruptRecords  corrupt;
+        if (loadStore(pFB, pFB->populationFile(), store, ixRecord, (pFB->onCorrupt() == argsAndErrs::eOnCorrupt_Skip) ? &corrupt : nullptr, ssErr))
+        {
+            reportFileErr(pFB, ssErr);
+            break;
+        }
+        corrupt.report(cerr, ixRecord); // stdout is the answers
+
+        // Every query is answered from the index over the population of each year (or from the last born= subset's)
+        yearCounter counter(store.range(), pFB->countEngine(), argsAndErrs::eArgMax_Deferred);
+        store.countInto(counter);
+        counter.finish();
+        yearIndex   index(counter.counts().data(), (size_t)counter.width());
+        yearCounter subset(store.range(), pFB->countEngine(), argsAndErrs::eArgMax_Deferred);
+        yearRange_t bornSubset(1, 0); // none yet
+        cout << "ok ready " << store.size() << " " << store.range().yrBeg << "-" << store.range().yrEnd << endl;
+
+        string strQuery;
+        while (getline(cin, strQuery))
+        {
+            if (strQuery.size() && strQuery[strQuery.size()-1] == '\r')
+                strQuery.erase(strQuery.size()-1);
+            if (strQuery == "quit")
+                break;
+            if (strQuery.find_first_not_of(" \t") == string::npos)
+                continue;
+
+            string strAnswer;
+            bool   fErr = answerQuery(store, index, subset, bornSubset, strQuery, strAnswer);
+            cout << (fErr ? "error " : "ok ") << strAnswer << endl;
+        }
+    } while (false);
+}
+
+//--------------------------------------------------------------------------
+// Name: answerQuery()
+// Desc:
+//        answer a --serve query:
+//          max [BEG-END] [born=BEG-END]  - '<most alive> <year>...', the year(s) (in BEG to END) with the most people alive
+//          count YEAR [born=BEG-END]     - '<alive>', the people alive in YEAR
+//          range BEG-END [born=BEG-END]  - '<alive>...', the people alive in each year BEG to END
+//          add BIRTH DEATH               - '<records>', after adding a person born in BIRTH who died in DEATH
+//          remove BIRTH DEATH            - '<records>', after removing such a person
+//          name FIRST;LAST               - '<people> <BIRTH-DEATH>...', the people with these names (kept by --names; the
+//                                          names may have spaces, and are split as a record's are), and the years of the
+//                                          first SERVE_NAME_MATCHES of them
+//          info                          - '<records> <BEG-END>', the records and years loaded
+//        The whole population's answers come from the index, in O(log n) (per year listed).
+//        born=BEG-END only counts the people born in those years: they are counted from the store into subset,
+//        which is kept for the next query with the same years (until a person is added or removed)
+// Params:
+//       store      - the population
+//       index      - range index over the population of each year of the store
+//       subset     - the finished population counts of the people born in bornSubset
+//       bornSubset - years of birth counted in subset
+//       strQuery   - the query
+//       strAnswer  - the answer, or what is wrong with the query
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool populationInfo::answerQuery(populationStore &store, yearIndex &index, yearCounter &subset, yearRange_t &bornSubset,
+                                 const string &strQuery, string &strAnswer)
+{
+    stringstream   ssQuery(strQuery);
+    string         strCmd;
+    vector<string> args;
+    ssQuery >> strCmd;
+    for (string strArg; ssQuery >> strArg; )
+        args.push_back(strArg);
+
+    const yearRange_t &range = store.range();
+    stringstream       ss;
+    if (strCmd == "name")
+    {
+        string strNames;
+        ssQuery.clear();
+        ssQuery.seekg(0);
+        ssQuery >> strCmd >> ws;
+        getline(ssQuery, strNames);
+        size_t ixDelim = strNames.find(_delim);
+        if (ixDelim == string::npos || strNames.find(_delim, ixDelim+1) != string::npos)
+        {
+            ss << "'name' needs FIRST" << _delim << "LAST, the first and last names";
+            strAnswer = ss.str();
+            return true;
+        }
+        if (!store.hasNames())
+        {
+            strAnswer = "the names were not kept (see --names)";
+            return true;
+        }
+        vector<size_t> ixPeople;
+        ss << store.findNamed(strNames.substr(0, ixDelim), strNames.substr(ixDelim+1), SERVE_NAME_MATCHES, ixPeople);
+        for (auto ixPerson : ixPeople)
+            ss << " " << range.yrBeg + store.births()[ixPerson] << "-" << range.yrBeg + store.deaths()[ixPerson];
+        strAnswer = ss.str();
+        return false;
+    }
+    if (strCmd == "add" || strCmd == "remove")
+    {
+        int yrBirth = 0;
+        int yrDeath = 0;
+        try
+        {
+            size_t cntUsedBirth = 0;
+            size_t cntUsedDeath = 0;
+            if (args.size() != 2)
+                throw false;
+            yrBirth = stoi(args[0], &cntUsedBirth);
+            yrDeath = stoi(args[1], &cntUsedDeath);
+            if (cntUsedBirth != args[0].size() || cntUsedDeath != args[1].size() || yrBirth < range.yrBeg || yrBirth > yrDeath || yrDeath > range.yrEnd)
+                throw false;
+        }
+        catch (...)
+        {
+            ss << "'" << strCmd << "' needs BIRTH DEATH, the years of birth and death (" << range.yrBeg << " <= BIRTH <= DEATH <= " << range.yrEnd << ")";
+            strAnswer = ss.str();
+            return true;
+        }
+        if (strCmd == "add")
+            store.addPerson(yrBirth, yrDeath);
+        else if (store.removePerson(yrBirth, yrDeath))
+        {
+            ss << "there is no person born in " << yrBirth << " who died in " << yrDeath;
+            strAnswer = ss.str();
+            return true;
+        }
+        index.addRange(yrBirth - range.yrBeg, yrDeath - range.yrBeg, (strCmd == "add") ? 1 : -1);
+        bornSubset = yearRange_t(1, 0); // subset no longer matches the store
+        ss << store.size();
+        strAnswer = ss.str();
+        return false;
+    }
+
+    bool        fSubset = false;
+    bool        fYears  = false;
+    yearRange_t years   = range;
+    for (auto &strArg : args)
+    {
+        if (strArg.compare(0, 5, "born=") == 0)
+        {
+            yearRange_t born;
+            if (argsAndErrs::parseYearRange(strArg.substr(5), born))
+            {
+                strAnswer = "born= needs to be BEG-END";
+                return true;
+            }
+            if (born != bornSubset)
+            {
+                subset = yearCounter(range, subset.isDiff() ? argsAndErrs::eCountEngine_DiffArray : argsAndErrs::eCountEngine_PerYear, argsAndErrs::eArgMax_Deferred);
+                store.countBornInto(subset, born);
+                subset.finish();
+                bornSubset = born;
+            }
+            fSubset = true;
+            continue;
+        }
+
+        // A single YEAR is a range of one year
+        string strYears = strArg;
+        if (strCmd == "count" && strYears.find('-') == string::npos)
+            strYears += "-" + strYears;
+        if (fYears || argsAndErrs::parseYearRange(strYears, years))
+        {
+            strAnswer = "'" + strArg + "' is not " + ((strCmd == "count") ? "a YEAR" : "BEG-END");
+            return true;
+        }
+        fYears = true;
+        if (years.yrBeg < range.yrBeg || years.yrEnd > range.yrEnd)
+        {
+            ss << "'" << strArg << "' is outside the years loaded (" << range.yrBeg << "-" << range.yrEnd << ")";
+            strAnswer = ss.str();
+            return true;
+        }
+    }
+
+    size_t           ixBeg   = (size_t)(years.yrBeg - range.yrBeg);
+    size_t           ixEnd   = (size_t)(years.yrEnd - range.yrBeg);
+    const long long *pSubset = subset.counts().data();
+    if (strCmd == "max")
+    {
+        list<long long> ixTies;
+        long long       cntMax;
+        if (fSubset)
+        {
+            cntMax = yearScan::maxOf(pSubset + ixBeg, ixEnd - ixBeg + 1);
+            yearScan::findTies(pSubset + ixBeg, ixEnd - ixBeg + 1, cntMax, ixTies);
+            for (auto &ixYear : ixTies)
+                ixYear += ixBeg;
+        }
+        else
+        {
+            cntMax = index.maxOf(ixBeg, ixEnd);
+            index.findTies(ixBeg, ixEnd, cntMax, ixTies);
+        }
+        ss << cntMax;
+        for (auto ixYear : ixTies)
+            ss << " " << range.yrBeg + ixYear;
+    }
+    else if ((strCmd == "count" || strCmd == "range") && fYears)
+    {
+        for (size_t ixYear = ixBeg; ixYear <= ixEnd; ixYear++)
+            ss << ((ixYear > ixBeg) ? " " : "") << (fSubset ? pSubset[ixYear] : index.at(ixYear));
+    }
+    else if (strCmd == "info")
+        ss << store.size() << " " << range.yrBeg << "-" << range.yrEnd;
+    else
+    {
+        strAnswer = (strCmd == "count" || strCmd == "range") ? "'" + strCmd + "' needs " + ((strCmd == "count") ? "a YEAR" : "BEG-END")
+                                                             : "unknown query '" + strCmd + "' (max, count, range, name, add, remove, info or quit)";
+        return true;
+    }
+    strAnswer = ss.str();
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: reportStats()
+// Desc:
+//        report where the time of the run went, and what it read (see runStats), to stderr, if --stats asks for it
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::reportStats()
+{
+    shared_ptr<argsAndErrs_t> pFB = _wpFb.lock();
+    if (pFB && _pStats)
+        _pStats->report(cerr, pFB->stats() == argsAndErrs::eStats_Json);
+}
+
+//--------------------------------------------------------------------------
+// Name: runBenchmark()
+// Desc:
+//        Generate populationFile with each of --bench's population sizes (on 1, 2, 4, ... --threads threads), then count
+//        it with every --parser, --engine and thread count, and report the throughput of each case as JSON, to stdout.
+//        Each case is timed BENCH_REPEATS times; the fastest run is reported, with the peak resident memory of its runs.
+//        The other options (--format, --reader, --years, --seed, ...) apply to every case.
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::runBenchmark()
+{
+    static const argsAndErrs::parser_t      parsers[] = { argsAndErrs::eParser_Fast, argsAndErrs::eParser_Tokens };
+    static const char                      *parserNames[] = { "fast", "tokens" };
+    static const argsAndErrs::countEngine_t engines[] = { argsAndErrs::eCountEngine_DiffArray, argsAndErrs::eCountEngine_PerYear };
+    static const char                      *engineNames[] = { "diff", "peryear" };
+
+    do
+    {
+        shared_ptr<argsAndErrs_t> pFB = _wpFb.lock();
+        if (pFB==nullptr || pFB.get()==nullptr)
+            break;
+
+        vector<int> threadCounts;
+        for (int cntThreads = 1; cntThreads < pFB->threadCount(); cntThreads *= 2)
+            threadCounts.push_back(cntThreads);
+        threadCounts.push_back(pFB->threadCount());
+
+        // Every case is run with a copy of the options; a checkpoint would skip the counting being timed
+        argsAndErrs_t args = *pFB;
+        args._fBench      = false;
+        args._fCheckpoint = false;
+        args._fused       = argsAndErrs::eFused_Off;
+        args._stats       = argsAndErrs::eStats_Off;
+
+        // The cases report their progress and results to cout, as usual; it is silenced while they run
+        ostream json(cout.rdbuf());
+        json << "{" << endl;
+        json << "  \"file\": "      << jsonString(pFB->populationFile()) << "," << endl;
+        json << "  \"format\": \""  << ((pFB->format() == argsAndErrs::eFormat_Binary) ? "binary" : "text") << "\"," << endl;
+        json << "  \"reader\": \""  << ((pFB->reader() == argsAndErrs::eReader_Mmap) ? "mmap" : (pFB->reader() == argsAndErrs::eReader_Buffered) ? "buffered" :
+                                         (pFB->reader() == argsAndErrs::eReader_Async) ? "async" : "stream") << "\"," << endl;
+        json << "  \"years\": \""   << pFB->yearRange().yrBeg << "-" << pFB->yearRange().yrEnd << "\"," << endl;
+        json << "  \"seed\": "      << pFB->seed() << "," << endl;
+        json << "  \"repeats\": "   << BENCH_REPEATS << "," << endl;
+        json << "  \"runs\": [";
+
+        const char *pSep = "";
+        bool fDoBreak = false;
+        for (auto populationSize : pFB->benchSizes())
+        {
+            long long cntBytes = -1;
+            for (auto cntThreads : threadCounts)
+            {
+                args._sizeOfPopulation = populationSize;
+                args._cntThreads       = cntThreads;
+                long long cntPeakRssKB = -1;
+                streambuf *pOut = cout.rdbuf(nullptr);
+                double seconds = benchCase(args, cntPeakRssKB);
+                cout.rdbuf(pOut);
+                if (( fDoBreak = ((cntBytes = fileSize(pFB->populationFile())) < 0) ))
+                    break;
+
+                json << pSep << endl << "    { \"phase\": \"generate\", \"records\": " << populationSize << ", \"bytes\": " << cntBytes
+                     << ", \"threads\": " << cntThreads << ", \"generator\": \"" << ((args.generator() == argsAndErrs::eGenerator_Stream) ? "stream" : "vector") << "\"";
+                json << ", \"seconds\": " << seconds << ", \"recordsPerSec\": " << populationSize / seconds << ", \"mbPerSec\": " << cntBytes / seconds / 1e6
+                     << ", \"peakRssKB\": " << cntPeakRssKB << " }" << flush;
+                pSep = ",";
+            }
+            if (fDoBreak)
+                break;
+
+            for (size_t ixParser = 0; ixParser < sizeof(parsers)/sizeof(parsers[0]); ixParser++)
+            {
+                for (size_t ixEngine = 0; ixEngine < sizeof(engines)/sizeof(engines[0]); ixEngine++)
+                {
+                    for (auto cntThreads : threadCounts)
+                    {
+                        args._sizeOfPopulation = -1;
+                        args._parser           = parsers[ixParser];
+                        args._countEngine      = engines[ixEngine];
+                        args._cntThreads       = cntThreads;
+                        long long cntPeakRssKB = -1;
+                        streambuf *pOut = cout.rdbuf(nullptr);
+                        double seconds = benchCase(args, cntPeakRssKB);
+                        cout.rdbuf(pOut);
+
+                        json << pSep << endl << "    { \"phase\": \"count\", \"records\": " << populationSize << ", \"bytes\": " << cntBytes
+                             << ", \"threads\": " << cntThreads << ", \"parser\": \"" << parserNames[ixParser] << "\", \"engine\": \"" << engineNames[ixEngine] << "\"";
+                        json << ", \"seconds\": " << seconds << ", \"recordsPerSec\": " << populationSize / seconds << ", \"mbPerSec\": " << cntBytes / seconds / 1e6
+                             << ", \"peakRssKB\": " << cntPeakRssKB << " }" << flush;
+                    }
+                }
+            }
+        }
+        json << endl << "  ]" << endl << "}" << endl;
+        if (fDoBreak)
+        {
+            stringstream ss;
+            ss <<  "    Unable to benchmark; nothing was generated into '" << pFB->populationFile() << "'." << endl;
+            reportFileErr(pFB, ss);
+        }
+    } while (false);
+}
+
+//--------------------------------------------------------------------------
+// Name: benchCase()
+// Desc:
+//        generate (if args has a population size) or count populationFile BENCH_REPEATS times, with the given options
+// Params:
+//       args         - the options of the case
+//       cntPeakRssKB - the peak resident memory of the runs, in KB (-1 where it can not be measured)
+// Returns:
+//      wall clock seconds of the fastest run
+//--------------------------------------------------------------------------
+double populationInfo::benchCase(const argsAndErrs_t &args, long long &cntPeakRssKB)
+{
+    shared_ptr<argsAndErrs_t> pArgs = make_shared<argsAndErrs_t>(args);
+    populationInfo            peeps(pArgs);
+    double                    secondsBest = 0;
+    for (int ixRepeat = 0; ixRepeat < BENCH_REPEATS; ixRepeat++)
+    {
+        resetPeakRss();
+        chrono::steady_clock::time_point tmBeg = chrono::steady_clock::now();
+        if (pArgs->needData())
+            peeps.generateVitalStats();
+        else
+            peeps.findMaxPopulationYear();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - tmBeg).count();
+
+        secondsBest  = (ixRepeat == 0) ? seconds : min(secondsBest, seconds);
+        cntPeakRssKB = max(cntPeakRssKB, peakRssKB());
+    }
+    return max(secondsBest, 1e-9);
+}
+
+//--------------------------------------------------------------------------
+// Name: resetPeakRss()
+// Desc:
+//        reset the process' peak resident memory to its current size (Linux only), so peakRssKB() measures the next run;
+//        elsewhere, peakRssKB() is the peak of the whole process
+// Params:
+//       <none>
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::resetPeakRss()
+{
+#ifdef __linux__
+    FILE *pFile = fopen("/proc/self/clear_refs", "w");
+    if (pFile)
+    {
+        fputs("5", pFile);
+        fclose(pFile);
+    }
+#endif
+}
+
+//--------------------------------------------------------------------------
+// Name: peakRssKB()
+// Desc:
+//        the process' peak resident memory (since resetPeakRss(), on Linux)
+// Params:
+//       <none>
+// Returns:
+//      peak resident memory, in KB; -1 if it can not be measured
+//--------------------------------------------------------------------------
+long long populationInfo::peakRssKB()
+{
+    long long cntKB = -1;
+#ifdef __linux__
+    ifstream status("/proc/self/status");
+    string   strLine;
+    while (getline(status, strLine))
+    {
+        if (strLine.compare(0, 6, "VmHWM:") == 0)
+            cntKB = atoll(strLine.c_str() + 6);
+    }
+#endif
+#ifndef _WIN32
+    struct rusage usage;
+    if (cntKB < 0 && getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef __APPLE__
+        cntKB = usage.ru_maxrss / 1024; // bytes on macOS
+#else
+        cntKB = usage.ru_maxrss;
+#endif
+    }
+#endif
+    return cntKB;
+}
+
+//--------------------------------------------------------------------------
+// Name: fileSize()
+// Desc:
+//        size of a file
+// Params:
+//       strFile - the file
+// Returns:
+//      bytes in the file; -1 if it can not be opened
+//--------------------------------------------------------------------------
+long long populationInfo::fileSize(const string &strFile)
+{
+    ifstream file(strFile.c_str(), ios::in | ios::binary | ios::ate);
+    if (!file.is_open())
+        return -1;
+    return (long long)file.tellg();
+}
+
+//--------------------------------------------------------------------------
+// Name: jsonString()
+// Desc:
+//        quote a string for JSON
+// Params:
+//       str - the string
+// Returns:
+//      the quoted, escaped, string
+//--------------------------------------------------------------------------
+string populationInfo::jsonString(const string &str)
+{
+    string strJson = "\"";
+    for (auto ch : str)
+    {
+        if (ch == '"' || ch == '\\')
+            strJson += '\\';
+        if ((unsigned char)ch < 0x20)
+        {
+            char hex[8];
+            snprintf(hex, sizeof(hex), "\\u%04x", (unsigned char)ch);
+            strJson += hex;
+            continue;
+        }
+        strJson += ch;
+    }
+    return strJson + "\"";
+}
+
+//--------------------------------------------------------------------------
+// Name: loadCheckpoint()
+// Desc:
+//        resume from the population file's checkpoint (see checkpoint_t), if it still matches the file:
+//        its counts are added to the counter, and counting continues from where it left off
+// Params:
+//       strFile    - the population file
+//       strCkpt    - its checkpoint file
+//       counter    - population counts to add the checkpoint's counts to
+//       offRecords - file offset of the first record (past any header)
+//       sizeRecord - bytes per fixed-width record; 0 for newline terminated records
+//       offResume  - file offset to continue counting from
+//       cntRecords - records already counted
+//       fFull      - hash all the covered bytes again (--checkpoint-verify=full); otherwise only check the edges
+//       hash       - the prefixHash of the records already counted
+//       log        - where to report whether the checkpoint was used
+// Returns:
+//      false if resumed; true if there is no usable checkpoint (everything is counted)
+//--------------------------------------------------------------------------
+bool populationInfo::loadCheckpoint(const string &strFile, const string &strCkpt, yearCounter &counter, unsigned long long offRecords, size_t sizeRecord,
+                                    unsigned long long &offResume, long long &cntRecords, bool fFull, prefixHash &hash, ostream &log)
+{
+    checkpoint_t       ckpt;
+    unsigned long long edges = 0;
+    string             strWhy;
+    if (ckpt.read(strCkpt))
+        strWhy = "there is no (supported) checkpoint";
+    else if (ckpt.countEngine != (counter.isDiff() ? argsAndErrs::eCountEngine_DiffArray : argsAndErrs::eCountEngine_PerYear))
+        strWhy = "it was made with another --engine";
+    else if (yearRange_t(ckpt.yrBeg, ckpt.yrEnd) != counter.range())
+        strWhy = "it was made with other --years";
+    else if (ckpt.offEnd < offRecords || (sizeRecord && (ckpt.offEnd - offRecords) % sizeRecord))
+        strWhy = "it does not end on a record of this file";
+    else if (ckpt.fileId != checkpoint_t::fileIdOf(strFile))
+        strWhy = "it was made for another file (inode)";
+    else if (checkpoint_t::edgesOf(strFile, offRecords, ckpt.offEnd, edges) || edges != ckpt.edges)
+        strWhy = "the part of the file it covers has changed";
+    else if (fFull && (checkpoint_t::hashOf(strFile, offRecords, ckpt.offEnd, hash) || hash.value() != ckpt.hash.value()))
+        strWhy = "the part of the file it covers has changed (--checkpoint-verify=full)";
+
+    hash = prefixHash();
+    if (strWhy.size())
+    {
+        log << "counting all records; " << strWhy << " in '" << strCkpt << "'" << endl;
+        return true;
+    }
+    counter.addBins(ckpt.bins.data());
+    hash       = ckpt.hash;
+    offResume  = ckpt.offEnd;
+    cntRecords = (long long)ckpt.cntRecords;
+    log << "resuming after " << cntRecords << " records (" << offResume << " bytes) counted in '" << strCkpt << "'" << endl;
+    return false;
+}
+
+//--------------------------------------------------------------------------
+// Name: saveCheckpoint()
+// Desc:
+//        save the counts of the records counted so far as the population file's checkpoint (see checkpoint_t)
+// Params:
+//       strFile    - the population file
+//       strFile    - the population file
+//       strCkpt    - its checkpoint file
+//       counter    - population counts, before finish()
+//       offRecords - file offset of the first record (past any header)
+//       offEnd     - file offset one past the last record counted
+//       cntRecords - records counted
+//       hash       - the prefixHash of the records counted
+//       log        - where to report the checkpoint
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::saveCheckpoint(const string &strFile, const string &strCkpt, const yearCounter &counter, unsigned long long offRecords,
+                                    unsigned long long offEnd, long long cntRecords, const prefixHash &hash, ostream &log)
+{
+    checkpoint_t ckpt;
+    ckpt.countEngine = counter.isDiff() ? argsAndErrs::eCountEngine_DiffArray : argsAndErrs::eCountEngine_PerYear;
+    ckpt.yrBeg       = counter.range().yrBeg;
+    ckpt.yrEnd       = counter.range().yrEnd;
+    ckpt.offEnd      = offEnd;
+    ckpt.cntRecords  = (unsigned long long)cntRecords;
+    ckpt.bins        = counter.counts();
+    ckpt.fileId      = checkpoint_t::fileIdOf(strFile);
+    ckpt.hash        = hash;
+    if (checkpoint_t::edgesOf(strFile, offRecords, offEnd, ckpt.edges) || ckpt.write(strCkpt))
+    {
+        log << "unable to save checkpoint '" << strCkpt << "'" << endl;
+        return;
+    }
+    log << "saved checkpoint '" << strCkpt << "' (" << cntRecords << " records, " << offEnd << " bytes)" << endl;
+}
+
+//--------------------------------------------------------------------------
+// Name: reportMaxYears()
+// Desc:
+//        Report the year(s) that the maximum number of people were alive
+// Params:
+//       strWhat - what was counted (named if there were no records)
+//       counter - the finished population counts
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::reportMaxYears(const string &strWhat, yearCounter &counter)
+{
+    do
+    {
+        const list<long long> &MaxYears = counter.maxYears();
+
+        size_t ixYear=0;
+        if (MaxYears.size() == 0)
+        {
+            cout << "There were no records to process in " << strWhat << endl;
+            break;
+        }
+        
+        cout << endl;
+        if (MaxYears.size() == 1)
+            cout << "The year ";
+        else
+        {
+            cout << "The " << MaxYears.size() << " years ";
+        }
+        cout << "with the the highest population (" << counter.maxAlive() << ") "<< ((MaxYears.size() == 1) ? "was:" : "were:") << endl;
+        cout << "{ "  ;
+        for (auto itMaxYr=MaxYears.begin(); itMaxYr!=MaxYears.end(); ++itMaxYr)
+        {
+            cout << (*itMaxYr + counter.range().yrBeg)  << ((++ixYear == MaxYears.size()) ? " }\n\n" : ", ");
+        }
+    } while (false);
+}
+
+//--------------------------------------------------------------------------
+// Name: reportDistribution()
+// Desc:
+//        Report the --top most populous years, and write the --histogram, from the same finished counts that
+//        reportMaxYears() reports (the input is not read again)
+// Params:
+//       pFB     - the options
+//       counter - the finished population counts
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::reportDistribution(shared_ptr<argsAndErrs_t> &pFB, const yearCounter &counter)
+{
+    if (pFB->topCount())
+    {
+        vector<long long> ixYears;
+        counter.topYears(pFB->topCount(), ixYears);
+        cout << "The " << ixYears.size() << " most populous years were:" << endl;
+        for (size_t ixTop = 0; ixTop < ixYears.size(); ixTop++)
+            cout << "   " << (ixYears[ixTop] + counter.range().yrBeg) << ": " << counter.counts()[ixYears[ixTop]] << endl;
+        cout << endl;
+    }
+    if (pFB->histogramFile().size())
+    {
+        if (writeHistogram(pFB->histogramFile(), counter))
+        {
+            stringstream ss;
+            ss <<  "    Unable to open specified file,'" << pFB->histogramFile() << "', for write." << endl;
+            reportFileErr(pFB, ss);
+            return;
+        }
+        cout << "wrote the population of each year to '" << pFB->histogramFile() << "'" << endl;
+    }
+}
+
+//--------------------------------------------------------------------------
+// Name: writeHistogram()
+// Desc:
+//        Write the population of every year to a file.
+//        CSV: a 'year,alive' header line, then one line per year.
+//        Binary (a FILE ending with .bin), little endian:
+//            [ 0.. 8) magic 'SGIHIST\0'  [ 8..12) version (1)  [12..14) yrBeg  [14..16) yrEnd
+//            then yrEnd-yrBeg+1 8 byte counts, one per year
+// Params:
+//       strFile - the file
+//       counter - the finished population counts
+// Returns:
+//      false if success; true if error
+//--------------------------------------------------------------------------
+bool populationInfo::writeHistogram(const string &strFile, const yearCounter &counter)
+{
+    static const char magic[8] = { 'S', 'G', 'I', 'H', 'I', 'S', 'T', '\0' };
+    string strExt  = ".bin";
+    bool   fBinary = strFile.size() >= strExt.size() && strFile.compare(strFile.size() - strExt.size(), strExt.size(), strExt) == 0;
+
+    ofstream outStream(strFile.c_str(), fBinary ? (ios::out | ios::binary) : ios::out);
+    if (!outStream.is_open())
+        return true;
+
+    const yearRange_t &range = counter.range();
+    outputBuffer       out(outStream);
+    if (fBinary)
+    {
+        out.put(magic, sizeof(magic));
+        out.put((char)1); out.put((char)0); out.put((char)0); out.put((char)0);
+        out.put((char)range.yrBeg); out.put((char)(range.yrBeg >> 8));
+        out.put((char)range.yrEnd); out.put((char)(range.yrEnd >> 8));
+        for (int ixYear = 0; ixYear < range.width(); ixYear++)
+        {
+            unsigned long long cntAlive = (unsigned long long)counter.counts()[ixYear];
+            for (int ixByte = 0; ixByte < 8; ixByte++)
+                out.put((char)(cntAlive >> (8*ixByte)));
+        }
+    }
+    else
+    {
+        out.put("year,alive\n");
+        for (int ixYear = 0; ixYear < range.width(); ixYear++)
+        {
+            out.putInt(range.yrBeg + ixYear);  out.put(',');
+            out.putInt(counter.counts()[ixYear]); out.put('\n');
+            out.endRecord();
+        }
+    }
+    out.flush();
+    return !outStream.good();
+}
+
+//--------------------------------------------------------------------------
+// Name: describeBadBinaryFile()
+// Desc:
+//        describes a binary population file that can not be counted
+// Params:
+//       ss      - where to describe the error
+//       strFile - the population file
+//       strWhy  - what is wrong with the file
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::describeBadBinaryFile(stringstream &ss, const string &strFile, const string &strWhy)
+{
+    ss <<  "    Binary population file,'" << strFile << "', can not be processed." << endl;
+    ss <<  "    " << strWhy << endl;
+}
+
+//--------------------------------------------------------------------------
+// Name: describeUnreadableFile()
+// Desc:
+//        describes a population file that could not be opened for read
+// Params:
+//       ss      - where to describe the error
+//       strFile - the population file
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::describeUnreadableFile(stringstream &ss, const string &strFile)
+{
+    ss <<  "    Unable to open specified file,'" << strFile << "', for read." << endl;
+}
+
+//--------------------------------------------------------------------------
+// Name: describeUnreadableData()
+// Desc:
+//        describes a population file whose data could not all be read: a read error, or corrupt compressed data
+// Params:
+//       ss       - where to describe the error
+//       strFile  - the population file
+//       ixRecord - the records read before it
+//       pWhy     - why it could not be read (see populationReader::whyFailed())
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::describeUnreadableData(stringstream &ss, const string &strFile, long long ixRecord, const char *pWhy)
+{
+    ss <<  "    Population file,'" << strFile << "', can not be read past record " << ixRecord << "." << endl;
+    ss <<  "    " << pWhy << endl;
+}
+
+//--------------------------------------------------------------------------
+// Name: reportFileErr()
+// Desc:
+//        reports an error described while counting the population file
+// Params:
+//       pFB - where to report the error
+//       ss  - the error (see describeCorruptRecord(), describeBadBinaryFile(), describeUnreadableFile())
+// Returns:
+//      void
+//--------------------------------------------------------------------------
+void populationInfo::reportFileErr(shared_ptr<argsAndErrs_t> &pFB, stringstream &ss)
+{
+    pFB->addCmdLnArgsToErr(ss);
+    string strErr = ss.str();
+    pFB.get()->reportErr(strErr);
+}
+
+int main(int argc, const char * argv[])
+{
+    bool fDoBreak = false;
+    do
+    {
+        string strErr;
+        argsAndErrs fb;
+    
+        //--------------------------------------------------------------------------------------------
+        // Input and sanity check command line args
+        //--------------------------------------------------------------------------------------------
+        if (( fDoBreak = fb.initWithArgs(argc,  argv, strErr) ))
+        {
+            fb.reportErr(strErr);
+            break;
+        }
+        
+        //--------------------------------------------------------------------------------------------
+        // Do the work - Find combinations of orginal message after hidden message chars are removed
+        //--------------------------------------------------------------------------------------------
+        shared_ptr<argsAndErrs_t>spFB = make_shared<argsAndErrs_t>(fb);
+        
+        populationInfo myPeeps(spFB);
+        if (fb.serve())
+        {
+            // Keep the babies around, and answer questions about them
+            myPeeps.serveQueries();
+            myPeeps.reportStats();
+            break;
+        }
+        if (fb.bench())
+        {
+            // Time the babies being made and counted, every which way
+            myPeeps.runBenchmark();
+            break;
+        }
+        if (fb.needData() && fb.fused() != argsAndErrs::eFused_Off)
+        {
+            // Count the babies as they are made, skipping the file round trip
+            myPeeps.generateAndCountVitalStats();
+            myPeeps.reportStats();
+            break;
+        }
+        if (fb.needData())
+        {
+            // Make some babies and see how long they last
+            myPeeps.generateVitalStats();
+        }
+        //else
+        {
+            // Muster Call
+            myPeeps.findMaxPopulationYear();
+        }
+        myPeeps.reportStats();
+    } while (false);
+    
+    return 0;
+}